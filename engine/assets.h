@@ -0,0 +1,173 @@
+#ifndef _EFFECTIVE_ASSETS_
+#define _EFFECTIVE_ASSETS_
+
+#include <stdint.h>
+#include <string.h>
+#include "core.h"
+#include "multithreader.h"
+#include "mesh.h"
+#include "mesh_cache.h"
+
+#define AS_MAX_PATH 1024
+#define AS_UPLOAD_VERTICES 65536
+#define AS_UPLOAD_INDICES (AS_UPLOAD_VERTICES * 3)
+
+typedef enum AssetState_e {
+    AS_STATE_INVALID = 0,
+    AS_STATE_LOADING,
+    AS_STATE_READY,
+    AS_STATE_FAILED,
+} AssetState_t;
+
+/**
+ * @brief Called on main thread when mesh is loaded, callback takes ownership of mesh streams (e.g. passes mesh to MDAddMesh). Failed load passes empty mesh
+ */
+typedef void (*PFN_ASMeshCallback)(void* pUser, uint32_t handle, Mesh_t* pMesh);
+
+typedef struct AssetRequest_s {
+    char mPath[AS_MAX_PATH];
+    bool mIndexed;
+    bool mCook;
+    Mesh_t mMesh;
+
+    PFN_ASMeshCallback mFn;
+    void* mUser;
+
+    uint32_t mHandle;
+} AssetRequest_t;
+
+/**
+ * @brief Asset states by handle, requests themselves are freed once delivered. Only main thread touches loader
+ */
+typedef struct AssetLoader_s {
+    AssetState_t* mStates;
+    uint32_t mStateCount;
+    uint32_t mLoadingCount;
+    uint32_t mUploadCount;
+} AssetLoader_t;
+
+AssetLoader_t gAssetLoader = { nullptr, 0, 0, 0 };
+
+/**
+ * @brief Delivers loaded mesh to its callback and frees request, runs on main thread
+ *
+ * @param pRequest
+ */
+void __ASDeliverMesh(void* pRequest) {
+    AssetRequest_t* request = (AssetRequest_t*)pRequest;
+    bool failed = request->mMesh.mMeshSize == 0;
+
+    gAssetLoader.mStates[request->mHandle - 1] = failed ? AS_STATE_FAILED : AS_STATE_READY;
+    gAssetLoader.mLoadingCount--;
+
+    if(request->mFn != nullptr) {
+        request->mFn(request->mUser, request->mHandle, &request->mMesh);
+    }
+    else if(request->mMesh.mMeshCapacity != 0) {
+        MFreeMesh(&request->mMesh);
+    }
+
+    MECFree(request);
+}
+
+/**
+ * @brief Reads and parses mesh, runs on task pool
+ *
+ * @param pRequest
+ */
+void __ASLoadMeshTask(void* pRequest) {
+    AssetRequest_t* request = (AssetRequest_t*)pRequest;
+
+    MLoadPLYMeshCached(&request->mMesh, request->mPath, request->mIndexed, request->mCook);
+
+    MTPostToMain(__ASDeliverMesh, request);
+}
+
+/**
+ * @brief Start loading .ply mesh in background (through .emesh cache, see MLoadPLYMeshCached), returns immediately. Finished mesh is passed to fn on main thread inside WRun loop, request memory is freed after fn returns. Call from main thread
+ *
+ * @param path .ply file path
+ * @param indexed load as indexed mesh
+ * @param cook cook indexed mesh (see MOCookMesh), otherwise mesh is delivered as in file
+ * @param fn completion callback
+ * @param pUser callback user data
+ * @return uint32_t asset handle, 0 when request cannot be made
+ */
+uint32_t ASLoadMesh(const char* path, bool indexed, bool cook, PFN_ASMeshCallback fn, void* pUser) {
+    if(strlen(path) >= AS_MAX_PATH) {
+        E_WARN_ARG("Asset path \"%s\" is too long!", path);
+
+        return 0;
+    }
+
+    AssetRequest_t* request = (AssetRequest_t*)MECCalloc(1, sizeof(AssetRequest_t));
+
+    strcpy(request->mPath, path);
+    request->mIndexed = indexed;
+    request->mCook = cook;
+    request->mFn = fn;
+    request->mUser = pUser;
+    MClearMesh(&request->mMesh);
+
+    gAssetLoader.mStates = (AssetState_t*)MECRealloc(gAssetLoader.mStates, sizeof(AssetState_t) * (gAssetLoader.mStateCount + 1));
+    gAssetLoader.mStates[gAssetLoader.mStateCount++] = AS_STATE_LOADING;
+    gAssetLoader.mLoadingCount++;
+    request->mHandle = gAssetLoader.mStateCount;
+
+    MTSubmit(__ASLoadMeshTask, request);
+
+    return request->mHandle;
+}
+
+/**
+ * @brief Get state of asset request
+ *
+ * @param handle asset handle
+ * @return AssetState_t
+ */
+AssetState_t ASGetState(uint32_t handle) {
+    if(handle == 0 || handle > gAssetLoader.mStateCount) {
+        return AS_STATE_INVALID;
+    }
+
+    return gAssetLoader.mStates[handle - 1];
+}
+
+/**
+ * @brief Uploads next chunk of render data mesh and posts itself again until whole mesh is uploaded, runs on main thread
+ *
+ * @param pRd render data pointer
+ */
+void __ASUploadChunk(void* pRd) {
+    if(!RDAppendMeshChunk((RenderData_t*)pRd, AS_UPLOAD_VERTICES, AS_UPLOAD_INDICES)) {
+        MTPostToMain(__ASUploadChunk, pRd);
+
+        return;
+    }
+
+    gAssetLoader.mUploadCount--;
+}
+
+/**
+ * @brief Bind mesh data to render data and upload it in chunks of AS_UPLOAD_VERTICES vertices and AS_UPLOAD_INDICES indices through main thread queue, so big mesh doesn`t take whole frame (see RDAppendMeshChunk). Render data draws uploaded part meanwhile and has to live until upload ends (see ASIsIdle)
+ *
+ * @param pRd render data pointer
+ * @param pMesh mesh data pointer
+ */
+void ASBindMesh(RenderData_t* pRd, MeshData_t* pMesh) {
+    pRd->mMeshPtr = pMesh;
+    gAssetLoader.mUploadCount++;
+
+    __ASUploadChunk(pRd);
+}
+
+/**
+ * @brief Check if every requested asset was delivered and uploaded
+ *
+ * @return true when nothing is loading
+ */
+bool ASIsIdle() {
+    return gAssetLoader.mLoadingCount == 0 && gAssetLoader.mUploadCount == 0;
+}
+
+#endif
@@ -5,6 +5,16 @@
 #include <stdint.h>
 #include <string.h>
 #include <stdlib.h>
+#include <stdatomic.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 #define E_ERR(msg) printf("\x1b[1;31m[ERROR]\x1b[0;31m: In %s at line %d in %s() : \x1b[0m%s\x1b[0m\n", __FILE__, __LINE__, __func__, msg); fflush(stdout);
 #define E_WARN(msg) printf("\x1b[1;33m[WARN]\x1b[0;33m: In %s at line %d in %s() : \x1b[0m%s\x1b[0m\n", __FILE__, __LINE__, __func__, msg); fflush(stdout);
@@ -19,19 +29,42 @@ const char* gSimpleVertexShaderSource =
 "uniform mat4 uProjection;\n"
 "uniform mat4 uView;\n"
 "uniform mat4 uTransform;\n"
+"uniform vec3 uPositionOffset = vec3(0.0);\n"
+"uniform vec3 uPositionScale = vec3(1.0);\n"
+"uniform bool uOctahedralNormals = false;\n"
+"uniform bool uGPUTransforms = false;\n"
+"layout(std430, binding = 0) readonly buffer MeshTransforms {\n"
+"   layout(row_major) mat4 uMeshTransforms[];\n"
+"};\n"
 "layout(location = 0) in vec4 iPos;\n"
 "layout(location = 1) in vec4 iCol;\n"
 "layout(location = 2) in vec3 iNorm;\n"
 "layout(location = 3) in vec2 iTexCoord;\n"
 "layout(location = 4) in float iTexId;\n"
+"layout(location = 5) in float iMeshId;\n"
 "out vec4 vCol;\n"
 "out vec3 vNorm;\n"
 "out vec2 vTexCoord;\n"
 "out float vTexId;\n"
+"vec3 decodeNormal(vec3 n) {\n"
+"   if(!uOctahedralNormals) return n;\n"
+"   vec3 r = vec3(n.xy, 1.0 - abs(n.x) - abs(n.y));\n"
+"   if(r.z < 0.0) r.xy = (1.0 - abs(r.yx)) * vec2(r.x >= 0.0 ? 1.0 : -1.0, r.y >= 0.0 ? 1.0 : -1.0);\n"
+"   return normalize(r);\n"
+"}\n"
 "void main() {\n"
-"   gl_Position = uProjection * uView * uTransform * iPos;\n"
+"   vec4 position = vec4(uPositionOffset + iPos.xyz * uPositionScale, 1.0);\n"
+"   vec3 normal = decodeNormal(iNorm);\n"
+"   if(uGPUTransforms) {\n"
+"       mat4 m = uMeshTransforms[int(iMeshId)];\n"
+"       mat3 c = mat3(cross(m[1].xyz, m[2].xyz), cross(m[2].xyz, m[0].xyz), cross(m[0].xyz, m[1].xyz));\n"
+"       position = m * position;\n"
+"       normal = c * normal * sign(dot(m[0].xyz, c[0]));\n"
+"       normal = dot(normal, normal) > 0.0 ? normalize(normal) : normal;\n"
+"   }\n"
+"   gl_Position = uProjection * uView * uTransform * position;\n"
 "   vCol = iCol;\n"
-"   vNorm = iNorm;\n"
+"   vNorm = normal;\n"
 "   vTexCoord = iTexCoord;\n"
 "   vTexId = iTexId;\n"
 "}\0";
@@ -115,6 +148,40 @@ double CBytesToDouble(uint64_t bytes) {
     return result;
 }
 
+/**
+ * @brief Memory Error Check counters, counted by every MEC call (e.g. for loader benchmarks)
+ */
+typedef struct MECStats_s {
+    uint64_t mMallocCount;
+    uint64_t mCallocCount;
+    uint64_t mReallocCount;
+    uint64_t mFreeCount;
+} MECStats_t;
+
+atomic_uint_fast64_t gMECMallocCount = 0;
+atomic_uint_fast64_t gMECCallocCount = 0;
+atomic_uint_fast64_t gMECReallocCount = 0;
+atomic_uint_fast64_t gMECFreeCount = 0;
+
+/**
+ * @brief Get Memory Error Check counters
+ * 
+ * @param pStats output counters
+ */
+void MECGetStats(MECStats_t* pStats) {
+    pStats->mMallocCount = atomic_load(&gMECMallocCount);
+    pStats->mCallocCount = atomic_load(&gMECCallocCount);
+    pStats->mReallocCount = atomic_load(&gMECReallocCount);
+    pStats->mFreeCount = atomic_load(&gMECFreeCount);
+}
+
+void MECResetStats() {
+    atomic_store(&gMECMallocCount, 0);
+    atomic_store(&gMECCallocCount, 0);
+    atomic_store(&gMECReallocCount, 0);
+    atomic_store(&gMECFreeCount, 0);
+}
+
 /**
  * @brief Memory Error Check free
  * 
@@ -129,6 +196,7 @@ void MECFree(void* allocPtr) {
     }
 
     free(allocPtr);
+    atomic_fetch_add_explicit(&gMECFreeCount, 1, memory_order_relaxed);
 
     allocPtr = nullptr;
 }
@@ -141,6 +209,7 @@ void MECFree(void* allocPtr) {
  */
 void* MECMalloc(size_t size) {
     void* result = malloc(size);
+    atomic_fetch_add_explicit(&gMECMallocCount, 1, memory_order_relaxed);
 
     if(result == nullptr) {
         E_ERR("Memory Error Check (MEC) malloc didn`t returned valid pointer!");
@@ -159,6 +228,7 @@ void* MECMalloc(size_t size) {
  */
 void* MECCalloc(size_t numberOfElements, size_t elementSize) {
     void* result = calloc(numberOfElements, elementSize);
+    atomic_fetch_add_explicit(&gMECCallocCount, 1, memory_order_relaxed);
 
     if(result == nullptr) {
         E_ERR("Memory Error Check (MEC) calloc didn`t returned valid pointer!");
@@ -185,6 +255,7 @@ void* MECRealloc(void* allocPtr, size_t size) {
     }*/
 
     allocPtr = realloc(allocPtr, size);
+    atomic_fetch_add_explicit(&gMECReallocCount, 1, memory_order_relaxed);
 
     if(allocPtr == nullptr) {
         E_ERR("Memory Error Check (MEC) realloc didn`t returned valid pointer!")
@@ -213,6 +284,214 @@ size_t SFindInString_Slow(const uint8_t* searched, const uint8_t* src) {
     return SIZE_MAX;
 }
 
+/**
+ * @brief Search Find memory block in source, bounded by source size (source don`t need to be null terminated)
+ * 
+ * @param searched searched bytes
+ * @param searchedSize searched bytes amount
+ * @param src source
+ * @param srcSize source size
+ * @return size_t index of first occurence or SIZE_MAX when not found
+ */
+size_t SFindInMemory(const uint8_t* searched, size_t searchedSize, const uint8_t* src, size_t srcSize) {
+    if(searchedSize == 0 || searchedSize > srcSize) {
+        return SIZE_MAX;
+    }
+
+    for(size_t i = 0; i <= srcSize - searchedSize; i++) {
+        const uint8_t* found = (const uint8_t*)memchr(src + i, searched[0], srcSize - searchedSize - i + 1);
+
+        if(found == nullptr) {
+            break;
+        }
+
+        i = (size_t)(found - src);
+
+        if(memcmp(src + i, searched, searchedSize) == 0) {
+            return i;
+        }
+    }
+
+    return SIZE_MAX;
+}
+
+typedef struct FileMap_s {
+    uint8_t* mData;
+    size_t mSize;
+    bool mMapped;
+#ifdef _WIN32
+    HANDLE mFile, mMapping;
+#endif
+} FileMap_t;
+
+/**
+ * @brief File Map open, maps whole file read only into memory. Falls back to reading file into allocated buffer when mapping is unavailable
+ * 
+ * @param pMap file map pointer
+ * @param path file path
+ * @return true when file data is available in pMap->mData
+ */
+bool FMOpen(FileMap_t* pMap, const char* path) {
+    memset(pMap, 0, sizeof(FileMap_t));
+
+#ifdef _WIN32
+    pMap->mFile = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+    if(pMap->mFile == INVALID_HANDLE_VALUE) {
+        E_WARN_ARG("Cannot open file \"%s\"!", path);
+
+        return false;
+    }
+
+    LARGE_INTEGER file_size;
+    GetFileSizeEx(pMap->mFile, &file_size);
+    pMap->mSize = (size_t)file_size.QuadPart;
+
+    if(pMap->mSize != 0) {
+        pMap->mMapping = CreateFileMappingA(pMap->mFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+        if(pMap->mMapping != nullptr) {
+            pMap->mData = (uint8_t*)MapViewOfFile(pMap->mMapping, FILE_MAP_READ, 0, 0, 0);
+            pMap->mMapped = pMap->mData != nullptr;
+        }
+    }
+
+    if(pMap->mMapped) {
+        return true;
+    }
+
+    if(pMap->mMapping != nullptr) CloseHandle(pMap->mMapping);
+    CloseHandle(pMap->mFile);
+    pMap->mMapping = nullptr;
+    pMap->mFile = nullptr;
+#else
+    int fd = open(path, O_RDONLY);
+
+    if(fd < 0) {
+        E_WARN_ARG("Cannot open file \"%s\"!", path);
+
+        return false;
+    }
+
+    struct stat file_stat;
+
+    if(fstat(fd, &file_stat) == 0 && file_stat.st_size > 0) {
+        pMap->mSize = (size_t)file_stat.st_size;
+
+        void* data = mmap(nullptr, pMap->mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if(data != MAP_FAILED) {
+#ifdef MADV_SEQUENTIAL
+            madvise(data, pMap->mSize, MADV_SEQUENTIAL);
+#endif
+
+            pMap->mData = (uint8_t*)data;
+            pMap->mMapped = true;
+        }
+    }
+
+    close(fd);
+
+    if(pMap->mMapped) {
+        return true;
+    }
+#endif
+
+    E_INFO_ARG("Cannot map \"%s\", reading it into memory instead", path);
+
+    FILE* file = fopen(path, "rb");
+
+    if(file == nullptr) {
+        E_WARN_ARG("Cannot open file \"%s\"!", path);
+
+        return false;
+    }
+
+    fseek(file, 0, SEEK_END);
+    pMap->mSize = (size_t)ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    if(pMap->mSize != 0) {
+        pMap->mData = (uint8_t*)MECMalloc(pMap->mSize);
+        pMap->mSize = fread(pMap->mData, sizeof(uint8_t), pMap->mSize, file);
+    }
+
+    fclose(file);
+
+    return pMap->mData != nullptr;
+}
+
+/**
+ * @brief File Map close, unmaps or frees file data
+ * 
+ * @param pMap file map pointer
+ */
+void FMClose(FileMap_t* pMap) {
+    if(pMap->mMapped) {
+#ifdef _WIN32
+        UnmapViewOfFile(pMap->mData);
+        CloseHandle(pMap->mMapping);
+        CloseHandle(pMap->mFile);
+#else
+        munmap(pMap->mData, pMap->mSize);
+#endif
+    }
+    else if(pMap->mData != nullptr) {
+        MECFree(pMap->mData);
+    }
+
+    memset(pMap, 0, sizeof(FileMap_t));
+}
+
+/**
+ * @brief File Map info, reads file size and last modification time without opening file
+ * 
+ * @param path file path
+ * @param pSize output file size in bytes
+ * @param pTime output last modification time (platform specific units)
+ * @return true when file exists
+ */
+bool FMGetInfo(const char* path, uint64_t* pSize, int64_t* pTime) {
+#ifdef _WIN32
+    WIN32_FILE_ATTRIBUTE_DATA attributes;
+
+    if(!GetFileAttributesExA(path, GetFileExInfoStandard, &attributes)) {
+        return false;
+    }
+
+    *pSize = ((uint64_t)attributes.nFileSizeHigh << 32) | attributes.nFileSizeLow;
+    *pTime = (int64_t)(((uint64_t)attributes.ftLastWriteTime.dwHighDateTime << 32) | attributes.ftLastWriteTime.dwLowDateTime);
+#else
+    struct stat file_stat;
+
+    if(stat(path, &file_stat) != 0) {
+        return false;
+    }
+
+    *pSize = (uint64_t)file_stat.st_size;
+    *pTime = (int64_t)file_stat.st_mtime;
+#endif
+
+    return true;
+}
+
+/**
+ * @brief 64 bit FNV-1a hash
+ * 
+ * @param src data
+ * @param size data size in bytes
+ * @return uint64_t 
+ */
+uint64_t CHashFNV1a(const uint8_t* src, size_t size) {
+    uint64_t hash = 0xcbf29ce484222325ull;
+
+    for(size_t i = 0; i < size; i++) {
+        hash = (hash ^ src[i]) * 0x100000001b3ull;
+    }
+
+    return hash;
+}
+
 /**
  * @brief Memory Error Check Copying some memory until value occours
  * 
@@ -278,4 +557,227 @@ size_t CopyNumber(void* dst, void* src, size_t size, uint8_t stopVal) {
     return size;
 }
 
+/**
+ * @brief Skips spaces, tabs and carriage returns (new line is not skipped)
+ * 
+ * @param cursor 
+ * @param end 
+ * @return const char* 
+ */
+const char* __CSkipBlank(const char* cursor, const char* end) {
+    while(cursor < end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\r')) cursor++;
+
+    return cursor;
+}
+
+/**
+ * @brief Parse float in place without copying or allocating, correctly rounded. Uses exact double fast path (mantissa <= 2^53, |exponent| <= 22) and falls back to strtof for long or extreme numbers
+ * 
+ * @param pCursor cursor pointer, moved past parsed number
+ * @param end end of source (source don`t need to be null terminated)
+ * @param pResult parsed value
+ * @return true when number was parsed
+ */
+bool CParseFloat(const char** pCursor, const char* end, float* pResult) {
+    static const double powers_of_ten[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    const char* start = __CSkipBlank(*pCursor, end);
+    const char* cursor = start;
+    bool negative = false;
+    bool truncated = false;
+    bool any_digit = false;
+    uint64_t mantissa = 0;
+    uint32_t digits = 0;
+    int32_t exponent = 0;
+
+    if(cursor < end && (*cursor == '-' || *cursor == '+')) {
+        negative = *cursor == '-';
+        cursor++;
+    }
+
+    for(; cursor < end && *cursor >= '0' && *cursor <= '9'; cursor++) {
+        any_digit = true;
+
+        if(digits < 19) {
+            mantissa = mantissa * 10 + (uint64_t)(*cursor - '0');
+            if(mantissa != 0) digits++;
+        }
+        else {
+            exponent++;
+            truncated |= *cursor != '0';
+        }
+    }
+
+    if(cursor < end && *cursor == '.') {
+        for(cursor++; cursor < end && *cursor >= '0' && *cursor <= '9'; cursor++) {
+            any_digit = true;
+
+            if(digits < 19) {
+                mantissa = mantissa * 10 + (uint64_t)(*cursor - '0');
+                if(mantissa != 0) digits++;
+                exponent--;
+            }
+            else {
+                truncated |= *cursor != '0';
+            }
+        }
+    }
+
+    if(!any_digit) {
+        if(cursor < end && (*cursor == 'n' || *cursor == 'N' || *cursor == 'i' || *cursor == 'I')) {
+            truncated = true;
+
+            while(cursor < end && *cursor != ' ' && *cursor != '\t' && *cursor != '\r' && *cursor != '\n') cursor++;
+        }
+        else {
+            *pCursor = start;
+
+            return false;
+        }
+    }
+
+    if(any_digit && cursor < end && (*cursor == 'e' || *cursor == 'E')) {
+        const char* exponent_start = cursor++;
+        bool exponent_negative = false;
+        int32_t exponent_value = 0;
+
+        if(cursor < end && (*cursor == '-' || *cursor == '+')) {
+            exponent_negative = *cursor == '-';
+            cursor++;
+        }
+
+        if(cursor < end && *cursor >= '0' && *cursor <= '9') {
+            for(; cursor < end && *cursor >= '0' && *cursor <= '9'; cursor++) {
+                if(exponent_value < 100000) exponent_value = exponent_value * 10 + (*cursor - '0');
+            }
+
+            exponent += exponent_negative ? -exponent_value : exponent_value;
+        }
+        else {
+            cursor = exponent_start;
+        }
+    }
+
+    *pCursor = cursor;
+
+    if(!truncated && mantissa == 0) {
+        *pResult = negative ? -0.0f : 0.0f;
+
+        return true;
+    }
+
+    if(!truncated && mantissa <= (1ull << 53) && exponent >= -22 && exponent <= 22) {
+        double value = (double)mantissa;
+        value = exponent < 0 ? value / powers_of_ten[-exponent] : value * powers_of_ten[exponent];
+
+        uint64_t bits;
+        memcpy(&bits, &value, sizeof(double));
+
+        // Double rounding can only go wrong when double result lies exactly between two floats
+        if((bits & 0x1fffffffull) != 0x10000000ull) {
+            *pResult = negative ? -(float)value : (float)value;
+
+            return true;
+        }
+    }
+
+    char number[128];
+    size_t size = (size_t)(cursor - start) < sizeof(number) - 1 ? (size_t)(cursor - start) : sizeof(number) - 1;
+
+    memcpy(number, start, size);
+    number[size] = '\0';
+
+    *pResult = strtof(number, nullptr);
+
+    return true;
+}
+
+/**
+ * @brief Parse unsigned integer in place without copying or allocating
+ * 
+ * @param pCursor cursor pointer, moved past parsed number
+ * @param end end of source (source don`t need to be null terminated)
+ * @param pResult parsed value
+ * @return true when number was parsed
+ */
+bool CParseUInt(const char** pCursor, const char* end, uint32_t* pResult) {
+    const char* cursor = __CSkipBlank(*pCursor, end);
+    uint64_t value = 0;
+
+    if(cursor < end && *cursor == '+') {
+        cursor++;
+    }
+
+    if(cursor >= end || *cursor < '0' || *cursor > '9') {
+        return false;
+    }
+
+    for(; cursor < end && *cursor >= '0' && *cursor <= '9'; cursor++) {
+        value = value * 10 + (uint64_t)(*cursor - '0');
+
+        if(value > UINT32_MAX) value = UINT32_MAX;
+    }
+
+    *pCursor = cursor;
+    *pResult = (uint32_t)value;
+
+    return true;
+}
+
+/**
+ * @brief Convert float to IEEE 754 half float bits, rounds to nearest even, overflow becomes infinity
+ * 
+ * @param value 
+ * @return uint16_t 
+ */
+uint16_t CFloatToHalf(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(uint32_t));
+
+    uint16_t sign = (uint16_t)((bits >> 16) & 0x8000);
+    uint32_t exponent = (bits >> 23) & 0xff;
+    uint32_t mantissa = bits & 0x7fffff;
+
+    if(exponent == 0xff) {
+        return sign | 0x7c00 | (mantissa != 0 ? 0x200 : 0);
+    }
+
+    int32_t half_exponent = (int32_t)exponent - 127 + 15;
+
+    if(half_exponent >= 0x1f) {
+        return sign | 0x7c00;
+    }
+
+    if(half_exponent <= 0) {
+        if(half_exponent < -10) {
+            return sign;
+        }
+
+        mantissa |= 0x800000;
+
+        uint32_t shift = (uint32_t)(14 - half_exponent);
+        uint32_t half_mantissa = mantissa >> shift;
+        uint32_t rest = mantissa & ((1u << shift) - 1);
+        uint32_t halfway = 1u << (shift - 1);
+
+        if(rest > halfway || (rest == halfway && (half_mantissa & 1))) {
+            half_mantissa++;
+        }
+
+        return sign | (uint16_t)half_mantissa;
+    }
+
+    uint32_t half = ((uint32_t)half_exponent << 10) | (mantissa >> 13);
+    uint32_t rest = mantissa & 0x1fff;
+
+    if(rest > 0x1000 || (rest == 0x1000 && (half & 1))) {
+        half++;
+    }
+
+    return sign | (uint16_t)half;
+}
+
 #endif
\ No newline at end of file
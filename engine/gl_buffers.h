@@ -103,7 +103,7 @@ typedef struct VArray_s {
 
 void VAInitialize(VArray_t *pVa) {
     if(!pVa->mCreated) {
-        glGenVertexArrays(1, &pVa->mId);
+        glCreateVertexArrays(1, &pVa->mId);
 
         pVa->mCreated = true;
     }
@@ -134,7 +134,7 @@ typedef struct VBuffer_s {
 
 void VBInitialize(VBuffer_t *pVb) {
     if(!pVb->mCreated) {
-        glGenBuffers(1, &pVb->mId);
+        glCreateBuffers(1, &pVb->mId);
 
         pVb->mCreated = true;
     }
@@ -153,12 +153,44 @@ void VBBindPlace(VBuffer_t *pVb, uint32_t index, uint32_t dimmensions) {
     glEnableVertexAttribArray(index);
 }
 
+/**
+ * @brief Bind buffer to vertex attribute with explicit component type, used by interleaved and quantized streams
+ * 
+ * @param pVb 
+ * @param index attribute location
+ * @param dimmensions components count
+ * @param type component type (GL_FLOAT, GL_UNSIGNED_SHORT, GL_HALF_FLOAT, ...)
+ * @param normalized map integer components to [0, 1] or [-1, 1]
+ * @param stride vertex size in bytes, 0 for tightly packed
+ * @param offset attribute offset in bytes
+ */
+void VBBindPlaceFormat(VBuffer_t *pVb, uint32_t index, uint32_t dimmensions, uint32_t type, bool normalized, uint32_t stride, size_t offset) {
+    VBBind(pVb);
+
+    glVertexAttribPointer(index, dimmensions, type, normalized, stride, (const void*)offset);
+    glEnableVertexAttribArray(index);
+}
+
 void VBBindData(VBuffer_t *pVb, void* data, uint32_t size) {
     VBBind(pVb);
 
     glBufferData(GL_ARRAY_BUFFER, size, data, GL_DYNAMIC_DRAW);
 }
 
+/**
+ * @brief Replace part of buffer data, buffer has to be already big enough
+ * 
+ * @param pVb 
+ * @param offset offset in bytes
+ * @param data 
+ * @param size size in bytes
+ */
+void VBBindSubData(VBuffer_t *pVb, size_t offset, const void* data, size_t size) {
+    VBBind(pVb);
+
+    glBufferSubData(GL_ARRAY_BUFFER, offset, size, data);
+}
+
 void VBDelete(VBuffer_t *pVb) {
     if(pVb->mCreated) {
         glDeleteBuffers(1, &pVb->mId);
@@ -167,6 +199,212 @@ void VBDelete(VBuffer_t *pVb) {
     }
 }
 
+#define VF_MAX_ATTRIBUTES 6
+#define VF_MAX_STREAMS 6
+
+/**
+ * @brief Attribute of vertex format, 0 dimmensions means attribute is not stored and shader gets constant value
+ */
+typedef struct VertexAttribute_s {
+    uint32_t mType;
+    uint32_t mDimmensions;
+    bool mNormalized;
+    uint32_t mStream;
+    uint32_t mOffset;
+} VertexAttribute_t;
+
+/**
+ * @brief Vertex format, attributes (indexed by shader location) are stored in streams (one vertex buffer each) at offset inside stream vertex. One stream with all attributes is interleaved format
+ */
+typedef struct VertexFormat_s {
+    VertexAttribute_t mAttributes[VF_MAX_ATTRIBUTES];
+    uint32_t mStrides[VF_MAX_STREAMS];
+    uint32_t mStreamCount;
+} VertexFormat_t;
+
+/**
+ * @brief Size of one component of vertex attribute type
+ * 
+ * @param type GL_FLOAT, GL_HALF_FLOAT, GL_(UNSIGNED_)BYTE or GL_(UNSIGNED_)SHORT
+ * @return uint32_t 0 for unsupported type
+ */
+uint32_t VFTypeSize(uint32_t type) {
+    switch(type) {
+        case GL_FLOAT: return 4;
+        case GL_HALF_FLOAT: case GL_SHORT: case GL_UNSIGNED_SHORT: return 2;
+        case GL_BYTE: case GL_UNSIGNED_BYTE: return 1;
+        default: return 0;
+    }
+}
+
+void VFInitialize(VertexFormat_t* pFormat) {
+    memset(pFormat, 0, sizeof(VertexFormat_t));
+}
+
+/**
+ * @brief Add attribute after attributes already in stream, it is aligned to its component size and stream stride is padded to 4 bytes
+ * 
+ * @param pFormat vertex format pointer
+ * @param location shader location
+ * @param stream stream (vertex buffer binding)
+ * @param type component type (see VFTypeSize)
+ * @param dimmensions components count (1 - 4)
+ * @param normalized map integer components to [0, 1] or [-1, 1]
+ */
+void VFAddAttribute(VertexFormat_t* pFormat, uint32_t location, uint32_t stream, uint32_t type, uint32_t dimmensions, bool normalized) {
+    uint32_t size = VFTypeSize(type);
+    uint32_t end = 0;
+
+    if(location >= VF_MAX_ATTRIBUTES || stream >= VF_MAX_STREAMS || size == 0 || dimmensions == 0 || dimmensions > 4) {
+        E_WARN_ARG("Invalid vertex attribute at location %u, it is not added!", location);
+
+        return;
+    }
+
+    for(uint32_t i = 0; i < VF_MAX_ATTRIBUTES; i++) {
+        const VertexAttribute_t* attribute = &pFormat->mAttributes[i];
+        uint32_t attribute_end = attribute->mOffset + attribute->mDimmensions * VFTypeSize(attribute->mType);
+
+        if(i != location && attribute->mDimmensions != 0 && attribute->mStream == stream && attribute_end > end) {
+            end = attribute_end;
+        }
+    }
+
+    uint32_t offset = (end + size - 1) / size * size;
+
+    pFormat->mAttributes[location] = (VertexAttribute_t){ type, dimmensions, normalized, stream, offset };
+    pFormat->mStrides[stream] = (offset + size * dimmensions + 3) / 4 * 4;
+    pFormat->mStreamCount = stream + 1 > pFormat->mStreamCount ? stream + 1 : pFormat->mStreamCount;
+}
+
+/**
+ * @brief Set attribute formats and stream bindings of vertex array from vertex format, attributes missing in format are disabled
+ * 
+ * @param pVa 
+ * @param pFormat vertex format pointer
+ */
+void VASetFormat(VArray_t *pVa, const VertexFormat_t* pFormat) {
+    VAInitialize(pVa);
+
+    for(uint32_t i = 0; i < VF_MAX_ATTRIBUTES; i++) {
+        const VertexAttribute_t* attribute = &pFormat->mAttributes[i];
+
+        if(attribute->mDimmensions == 0) {
+            glDisableVertexArrayAttrib(pVa->mId, i);
+
+            continue;
+        }
+
+        glEnableVertexArrayAttrib(pVa->mId, i);
+        glVertexArrayAttribFormat(pVa->mId, i, attribute->mDimmensions, attribute->mType, attribute->mNormalized, attribute->mOffset);
+        glVertexArrayAttribBinding(pVa->mId, i, attribute->mStream);
+    }
+}
+
+/**
+ * @brief Attach buffer to stream of vertex array
+ * 
+ * @param pVa 
+ * @param stream stream (vertex buffer binding)
+ * @param pVb 
+ * @param stride stream vertex size in bytes
+ */
+void VABindStream(VArray_t *pVa, uint32_t stream, VBuffer_t *pVb, uint32_t stride) {
+    VAInitialize(pVa);
+    VBInitialize(pVb);
+
+    glVertexArrayVertexBuffer(pVa->mId, stream, pVb->mId, 0, stride);
+}
+
+typedef struct IBuffer_s {
+    uint32_t mId;
+    bool mCreated;
+} IBuffer_t;
+
+void IBInitialize(IBuffer_t *pIb) {
+    if(!pIb->mCreated) {
+        glGenBuffers(1, &pIb->mId);
+
+        pIb->mCreated = true;
+    }
+}
+
+/**
+ * @brief Bind element (index) buffer, binding is stored in currently bound vertex array
+ * 
+ * @param pIb 
+ */
+void IBBind(IBuffer_t *pIb) {
+    IBInitialize(pIb);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, pIb->mId);
+}
+
+void IBBindData(IBuffer_t *pIb, void* data, uint32_t size) {
+    IBBind(pIb);
+
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, data, GL_DYNAMIC_DRAW);
+}
+
+void IBBindSubData(IBuffer_t *pIb, size_t offset, const void* data, size_t size) {
+    IBBind(pIb);
+
+    glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, offset, size, data);
+}
+
+void IBDelete(IBuffer_t *pIb) {
+    if(pIb->mCreated) {
+        glDeleteBuffers(1, &pIb->mId);
+
+        pIb->mCreated = false;
+    }
+}
+
+typedef struct SBuffer_s {
+    uint32_t mId;
+    bool mCreated;
+} SBuffer_t;
+
+void SBInitialize(SBuffer_t *pSb) {
+    if(!pSb->mCreated) {
+        glCreateBuffers(1, &pSb->mId);
+
+        pSb->mCreated = true;
+    }
+}
+
+/**
+ * @brief Bind shader storage buffer to binding point of std430 block
+ * 
+ * @param pSb 
+ * @param binding block binding
+ */
+void SBBindBase(SBuffer_t *pSb, uint32_t binding) {
+    SBInitialize(pSb);
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, pSb->mId);
+}
+
+void SBBindData(SBuffer_t *pSb, const void* data, size_t size) {
+    SBInitialize(pSb);
+
+    glNamedBufferData(pSb->mId, size, data, GL_DYNAMIC_DRAW);
+}
+
+void SBBindSubData(SBuffer_t *pSb, size_t offset, const void* data, size_t size) {
+    SBInitialize(pSb);
+
+    glNamedBufferSubData(pSb->mId, offset, size, data);
+}
+
+void SBDelete(SBuffer_t *pSb) {
+    if(pSb->mCreated) {
+        glDeleteBuffers(1, &pSb->mId);
+
+        pSb->mCreated = false;
+    }
+}
+
 typedef struct TextureArray_s {
     uint32_t mId;
     bool mCreated;
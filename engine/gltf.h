@@ -0,0 +1,637 @@
+#ifndef _EFFECTIVE_GLTF_
+#define _EFFECTIVE_GLTF_
+
+#include <stdint.h>
+#include <string.h>
+#include "core.h"
+#include "ply.h"
+#include "mesh.h"
+
+#define GLB_MAGIC 0x46546C67u
+#define GLB_VERSION 2
+#define GLB_CHUNK_JSON 0x4E4F534Au
+#define GLB_CHUNK_BIN 0x004E4942u
+#define GLB_JSON_MAX_DEPTH 64
+#define GLB_MODE_TRIANGLES 4
+
+typedef enum GLBJsonType_e {
+    GLB_JSON_OBJECT,
+    GLB_JSON_ARRAY,
+    GLB_JSON_STRING,
+    GLB_JSON_PRIMITIVE
+} GLBJsonType_t;
+
+/**
+ * @brief JSON token pointing into source text (strings without quotes). Size is amount of direct children (object keys and values both count), next is index of token after whole subtree
+ */
+typedef struct GLBJsonToken_s {
+    GLBJsonType_t mType;
+    uint32_t mStart;
+    uint32_t mEnd;
+    uint32_t mSize;
+    uint32_t mNext;
+} GLBJsonToken_t;
+
+typedef struct GLBJson_s {
+    const char* mText;
+    GLBJsonToken_t* mTokens;
+    uint32_t mCount;
+    uint32_t mCapacity;
+} GLBJson_t;
+
+/**
+ * @brief glTF accessor resolved to BIN chunk, component type is GL type (glTF uses same values). Count 0 means accessor is missing
+ */
+typedef struct GLBAccessor_s {
+    size_t mOffset;
+    uint32_t mStride;
+    uint32_t mComponentType;
+    uint32_t mComponents;
+    uint32_t mCount;
+    bool mNormalized;
+} GLBAccessor_t;
+
+/**
+ * @brief glTF mesh primitive, attributes are in shader location order (POSITION, COLOR_0, NORMAL, TEXCOORD_0)
+ */
+typedef struct GLBPrimitive_s {
+    GLBAccessor_t mAttributes[4];
+    GLBAccessor_t mIndices;
+    uint32_t mMode;
+    uint32_t mMesh;
+} GLBPrimitive_t;
+
+/**
+ * @brief Mapped .glb file, BIN chunk points straight into mapping and is valid until GLBClose
+ */
+typedef struct GLBFile_s {
+    FileMap_t mFile;
+    const uint8_t* mBinary;
+    size_t mBinarySize;
+
+    GLBPrimitive_t* mPrimitives;
+    uint32_t mPrimitiveCount;
+} GLBFile_t;
+
+/**
+ * @brief Adds token and counts it as child of innermost open container
+ *
+ * @param pJson json pointer
+ * @param type token type
+ * @param start token start
+ * @param end token end
+ * @param stack open containers
+ * @param depth amount of open containers
+ * @return uint32_t token index
+ */
+uint32_t __GLBJsonPush(GLBJson_t* pJson, GLBJsonType_t type, uint32_t start, uint32_t end, const uint32_t* stack, uint32_t depth) {
+    if(pJson->mCount == pJson->mCapacity) {
+        pJson->mCapacity = pJson->mCapacity == 0 ? 256 : pJson->mCapacity * 2;
+        pJson->mTokens = MECRealloc(pJson->mTokens, sizeof(GLBJsonToken_t) * pJson->mCapacity);
+    }
+
+    if(depth != 0) {
+        pJson->mTokens[stack[depth - 1]].mSize++;
+    }
+
+    pJson->mTokens[pJson->mCount] = (GLBJsonToken_t){ type, start, end, 0, pJson->mCount + 1 };
+
+    return pJson->mCount++;
+}
+
+/**
+ * @brief Tokenize JSON text in one pass without copying it (string escapes are kept as they are, glTF keys don`t use them)
+ *
+ * @param pJson json pointer
+ * @param text JSON text
+ * @param size text size
+ * @return true when JSON is well nested
+ */
+bool __GLBJsonParse(GLBJson_t* pJson, const char* text, uint32_t size) {
+    uint32_t stack[GLB_JSON_MAX_DEPTH];
+    uint32_t depth = 0;
+
+    memset(pJson, 0, sizeof(GLBJson_t));
+    pJson->mText = text;
+
+    for(uint32_t i = 0; i < size; i++) {
+        char c = text[i];
+
+        if(c == '{' || c == '[') {
+            if(depth == GLB_JSON_MAX_DEPTH) {
+                return false;
+            }
+
+            stack[depth] = __GLBJsonPush(pJson, c == '{' ? GLB_JSON_OBJECT : GLB_JSON_ARRAY, i, i, stack, depth);
+            depth++;
+        }
+        else if(c == '}' || c == ']') {
+            if(depth == 0 || pJson->mTokens[stack[depth - 1]].mType != (c == '}' ? GLB_JSON_OBJECT : GLB_JSON_ARRAY)) {
+                return false;
+            }
+
+            GLBJsonToken_t* token = &pJson->mTokens[stack[--depth]];
+            token->mEnd = i + 1;
+            token->mNext = pJson->mCount;
+        }
+        else if(c == '"') {
+            uint32_t start = i + 1;
+
+            for(i = start; i < size && text[i] != '"'; i++) {
+                if(text[i] == '\\') i++;
+            }
+
+            if(i >= size) {
+                return false;
+            }
+
+            __GLBJsonPush(pJson, GLB_JSON_STRING, start, i, stack, depth);
+        }
+        else if(c != ' ' && c != '\t' && c != '\r' && c != '\n' && c != ',' && c != ':' && c != '\0') {
+            uint32_t start = i;
+
+            while(i < size && text[i] != ',' && text[i] != '}' && text[i] != ']' && text[i] != ' ' && text[i] != '\t' && text[i] != '\r' && text[i] != '\n') {
+                i++;
+            }
+
+            __GLBJsonPush(pJson, GLB_JSON_PRIMITIVE, start, i, stack, depth);
+            i--;
+        }
+    }
+
+    return depth == 0 && pJson->mCount != 0;
+}
+
+/**
+ * @brief Value of object member
+ *
+ * @param pJson json pointer
+ * @param object object token, may be -1
+ * @param key member name
+ * @return int32_t value token or -1 when object has no such member
+ */
+int32_t __GLBJsonFind(const GLBJson_t* pJson, int32_t object, const char* key) {
+    if(object < 0 || pJson->mTokens[object].mType != GLB_JSON_OBJECT) {
+        return -1;
+    }
+
+    size_t key_size = strlen(key);
+    uint32_t child = (uint32_t)object + 1;
+
+    for(uint32_t i = 0; i + 1 < pJson->mTokens[object].mSize; i += 2) {
+        const GLBJsonToken_t* name = &pJson->mTokens[child];
+        uint32_t value = name->mNext;
+
+        if(name->mType == GLB_JSON_STRING && name->mEnd - name->mStart == key_size && memcmp(pJson->mText + name->mStart, key, key_size) == 0) {
+            return (int32_t)value;
+        }
+
+        child = pJson->mTokens[value].mNext;
+    }
+
+    return -1;
+}
+
+/**
+ * @brief Array item
+ *
+ * @param pJson json pointer
+ * @param array array token, may be -1
+ * @param index item index
+ * @return int32_t item token or -1 when index is out of array
+ */
+int32_t __GLBJsonItem(const GLBJson_t* pJson, int32_t array, uint32_t index) {
+    if(array < 0 || pJson->mTokens[array].mType != GLB_JSON_ARRAY || index >= pJson->mTokens[array].mSize) {
+        return -1;
+    }
+
+    uint32_t child = (uint32_t)array + 1;
+
+    for(uint32_t i = 0; i < index; i++) {
+        child = pJson->mTokens[child].mNext;
+    }
+
+    return (int32_t)child;
+}
+
+uint32_t __GLBJsonCount(const GLBJson_t* pJson, int32_t array) {
+    return array < 0 || pJson->mTokens[array].mType != GLB_JSON_ARRAY ? 0 : pJson->mTokens[array].mSize;
+}
+
+uint32_t __GLBJsonUInt(const GLBJson_t* pJson, int32_t token, uint32_t fallback) {
+    uint32_t value = fallback;
+
+    if(token >= 0 && pJson->mTokens[token].mType == GLB_JSON_PRIMITIVE) {
+        const char* cursor = pJson->mText + pJson->mTokens[token].mStart;
+
+        if(!CParseUInt(&cursor, pJson->mText + pJson->mTokens[token].mEnd, &value)) {
+            value = fallback;
+        }
+    }
+
+    return value;
+}
+
+bool __GLBJsonBool(const GLBJson_t* pJson, int32_t token) {
+    return token >= 0 && pJson->mTokens[token].mType == GLB_JSON_PRIMITIVE && pJson->mText[pJson->mTokens[token].mStart] == 't';
+}
+
+bool __GLBJsonStringIs(const GLBJson_t* pJson, int32_t token, const char* string) {
+    if(token < 0 || pJson->mTokens[token].mType != GLB_JSON_STRING) {
+        return false;
+    }
+
+    size_t size = strlen(string);
+
+    return pJson->mTokens[token].mEnd - pJson->mTokens[token].mStart == size && memcmp(pJson->mText + pJson->mTokens[token].mStart, string, size) == 0;
+}
+
+/**
+ * @brief Size of glTF component type
+ *
+ * @param componentType GL_BYTE, GL_UNSIGNED_BYTE, GL_SHORT, GL_UNSIGNED_SHORT, GL_UNSIGNED_INT or GL_FLOAT
+ * @return uint32_t size in bytes, 0 for unknown type
+ */
+uint32_t __GLBComponentSize(uint32_t componentType) {
+    switch(componentType) {
+        case GL_BYTE: case GL_UNSIGNED_BYTE: return 1;
+        case GL_SHORT: case GL_UNSIGNED_SHORT: return 2;
+        case GL_UNSIGNED_INT: case GL_FLOAT: return 4;
+        default: return 0;
+    }
+}
+
+PLYType_t __GLBComponentPLYType(uint32_t componentType) {
+    switch(componentType) {
+        case GL_BYTE: return PLY_TYPE_CHAR;
+        case GL_UNSIGNED_BYTE: return PLY_TYPE_UCHAR;
+        case GL_SHORT: return PLY_TYPE_SHORT;
+        case GL_UNSIGNED_SHORT: return PLY_TYPE_USHORT;
+        case GL_UNSIGNED_INT: return PLY_TYPE_UINT;
+        case GL_FLOAT: return PLY_TYPE_FLOAT;
+        default: return PLY_TYPE_NONE;
+    }
+}
+
+uint32_t __GLBTypeComponents(const GLBJson_t* pJson, int32_t token) {
+    if(__GLBJsonStringIs(pJson, token, "SCALAR")) return 1;
+    if(__GLBJsonStringIs(pJson, token, "VEC2")) return 2;
+    if(__GLBJsonStringIs(pJson, token, "VEC3")) return 3;
+    if(__GLBJsonStringIs(pJson, token, "VEC4")) return 4;
+
+    return 0;
+}
+
+/**
+ * @brief Resolve accessor through its buffer view into BIN chunk. Sparse accessors, accessors without buffer view and external buffers are not supported
+ *
+ * @param pJson json pointer
+ * @param root root object token
+ * @param index accessor index
+ * @param binarySize BIN chunk size
+ * @param pAccessor output accessor
+ * @return true when accessor lies inside BIN chunk
+ */
+bool __GLBReadAccessor(const GLBJson_t* pJson, int32_t root, uint32_t index, size_t binarySize, GLBAccessor_t* pAccessor) {
+    int32_t accessor = __GLBJsonItem(pJson, __GLBJsonFind(pJson, root, "accessors"), index);
+    int32_t view = __GLBJsonItem(pJson, __GLBJsonFind(pJson, root, "bufferViews"), __GLBJsonUInt(pJson, __GLBJsonFind(pJson, accessor, "bufferView"), UINT32_MAX));
+
+    memset(pAccessor, 0, sizeof(GLBAccessor_t));
+
+    if(accessor < 0 || view < 0 || __GLBJsonFind(pJson, accessor, "sparse") >= 0 || __GLBJsonUInt(pJson, __GLBJsonFind(pJson, view, "buffer"), 0) != 0) {
+        return false;
+    }
+
+    pAccessor->mComponentType = __GLBJsonUInt(pJson, __GLBJsonFind(pJson, accessor, "componentType"), 0);
+    pAccessor->mComponents = __GLBTypeComponents(pJson, __GLBJsonFind(pJson, accessor, "type"));
+    pAccessor->mCount = __GLBJsonUInt(pJson, __GLBJsonFind(pJson, accessor, "count"), 0);
+    pAccessor->mNormalized = __GLBJsonBool(pJson, __GLBJsonFind(pJson, accessor, "normalized"));
+
+    uint32_t component_size = __GLBComponentSize(pAccessor->mComponentType);
+    uint32_t element_size = component_size * pAccessor->mComponents;
+    size_t view_offset = __GLBJsonUInt(pJson, __GLBJsonFind(pJson, view, "byteOffset"), 0);
+    size_t view_size = __GLBJsonUInt(pJson, __GLBJsonFind(pJson, view, "byteLength"), 0);
+
+    pAccessor->mStride = __GLBJsonUInt(pJson, __GLBJsonFind(pJson, view, "byteStride"), element_size);
+    pAccessor->mOffset = view_offset + __GLBJsonUInt(pJson, __GLBJsonFind(pJson, accessor, "byteOffset"), 0);
+
+    bool valid = element_size != 0 && pAccessor->mCount != 0 && pAccessor->mStride >= element_size && pAccessor->mOffset % component_size == 0;
+    valid = valid && view_offset + view_size <= binarySize && pAccessor->mOffset + (size_t)(pAccessor->mCount - 1) * pAccessor->mStride + element_size <= view_offset + view_size;
+
+    if(!valid) {
+        memset(pAccessor, 0, sizeof(GLBAccessor_t));
+    }
+
+    return valid;
+}
+
+/**
+ * @brief Resolve primitive attributes and indices. Primitive without valid POSITION or with invalid indices is rejected, other invalid attributes are left missing
+ *
+ * @param pJson json pointer
+ * @param root root object token
+ * @param primitive primitive token
+ * @param binarySize BIN chunk size
+ * @param pPrimitive output primitive
+ * @return true when primitive can be drawn
+ */
+bool __GLBReadPrimitive(const GLBJson_t* pJson, int32_t root, int32_t primitive, size_t binarySize, GLBPrimitive_t* pPrimitive) {
+    static const char* attribute_names[4] = { "POSITION", "COLOR_0", "NORMAL", "TEXCOORD_0" };
+    static const uint32_t attribute_components[4] = { 3, 4, 3, 2 };
+
+    int32_t attributes = __GLBJsonFind(pJson, primitive, "attributes");
+    int32_t indices = __GLBJsonFind(pJson, primitive, "indices");
+
+    memset(pPrimitive, 0, sizeof(GLBPrimitive_t));
+    pPrimitive->mMode = __GLBJsonUInt(pJson, __GLBJsonFind(pJson, primitive, "mode"), GLB_MODE_TRIANGLES);
+
+    for(uint32_t i = 0; i < 4; i++) {
+        int32_t attribute = __GLBJsonFind(pJson, attributes, attribute_names[i]);
+        GLBAccessor_t* accessor = &pPrimitive->mAttributes[i];
+
+        if(attribute < 0) {
+            continue;
+        }
+
+        bool valid = __GLBReadAccessor(pJson, root, __GLBJsonUInt(pJson, attribute, UINT32_MAX), binarySize, accessor);
+        valid = valid && accessor->mComponents <= attribute_components[i] && accessor->mComponentType != GL_UNSIGNED_INT;
+        valid = valid && (i == 0 || accessor->mCount == pPrimitive->mAttributes[0].mCount);
+
+        if(!valid) {
+            E_WARN_ARG("Unsupported %s accessor, attribute is skipped!", attribute_names[i]);
+
+            memset(accessor, 0, sizeof(GLBAccessor_t));
+        }
+    }
+
+    if(pPrimitive->mAttributes[0].mCount == 0) {
+        return false;
+    }
+
+    if(indices >= 0) {
+        GLBAccessor_t* accessor = &pPrimitive->mIndices;
+        bool valid = __GLBReadAccessor(pJson, root, __GLBJsonUInt(pJson, indices, UINT32_MAX), binarySize, accessor);
+
+        valid = valid && accessor->mComponents == 1 && (accessor->mComponentType == GL_UNSIGNED_BYTE || accessor->mComponentType == GL_UNSIGNED_SHORT || accessor->mComponentType == GL_UNSIGNED_INT);
+
+        // element buffer has no stride, indices have to be tightly packed
+        return valid && accessor->mStride == __GLBComponentSize(accessor->mComponentType);
+    }
+
+    return true;
+}
+
+void GLBClose(GLBFile_t* pFile) {
+    if(pFile->mPrimitives != nullptr) {
+        MECFree(pFile->mPrimitives);
+    }
+
+    FMClose(&pFile->mFile);
+
+    memset(pFile, 0, sizeof(GLBFile_t));
+}
+
+/**
+ * @brief Map .glb file, parse its JSON chunk and resolve every mesh primitive into BIN chunk. Vertex data is not touched
+ *
+ * @param pFile glb file pointer
+ * @param path .glb file path
+ * @return true when file has at least one drawable primitive
+ */
+bool GLBOpen(GLBFile_t* pFile, const char* path) {
+    memset(pFile, 0, sizeof(GLBFile_t));
+
+    if(!FMOpen(&pFile->mFile, path)) {
+        return false;
+    }
+
+    const uint8_t* data = pFile->mFile.mData;
+    uint32_t header[5] = {0};
+
+    if(pFile->mFile.mSize >= sizeof(header)) {
+        memcpy(header, data, sizeof(header));
+    }
+
+    // header: magic, version, length, then JSON chunk length and type
+    if(header[0] != GLB_MAGIC || header[1] != GLB_VERSION || header[2] > pFile->mFile.mSize || header[4] != GLB_CHUNK_JSON || (size_t)header[3] + sizeof(header) > header[2]) {
+        E_WARN_ARG("\"%s\" is not binary glTF 2.0 file!", path);
+
+        GLBClose(pFile);
+
+        return false;
+    }
+
+    size_t bin_chunk = (sizeof(header) + (size_t)header[3] + 3) & ~(size_t)3;
+    uint32_t bin_header[2] = {0};
+
+    if(bin_chunk + sizeof(bin_header) <= header[2]) {
+        memcpy(bin_header, data + bin_chunk, sizeof(bin_header));
+    }
+
+    if(bin_header[1] == GLB_CHUNK_BIN && bin_chunk + sizeof(bin_header) + bin_header[0] <= header[2]) {
+        pFile->mBinary = data + bin_chunk + sizeof(bin_header);
+        pFile->mBinarySize = bin_header[0];
+    }
+
+    GLBJson_t json;
+
+    if(!__GLBJsonParse(&json, (const char*)data + sizeof(header), header[3]) || json.mTokens[0].mType != GLB_JSON_OBJECT) {
+        E_WARN_ARG("Invalid JSON chunk in \"%s\"!", path);
+
+        if(json.mTokens != nullptr) {
+            MECFree(json.mTokens);
+        }
+
+        GLBClose(pFile);
+
+        return false;
+    }
+
+    int32_t meshes = __GLBJsonFind(&json, 0, "meshes");
+    uint32_t primitive_count = 0;
+
+    for(uint32_t m = 0; m < __GLBJsonCount(&json, meshes); m++) {
+        primitive_count += __GLBJsonCount(&json, __GLBJsonFind(&json, __GLBJsonItem(&json, meshes, m), "primitives"));
+    }
+
+    if(primitive_count != 0) {
+        pFile->mPrimitives = (GLBPrimitive_t*)MECCalloc(primitive_count, sizeof(GLBPrimitive_t));
+    }
+
+    for(uint32_t m = 0; m < __GLBJsonCount(&json, meshes); m++) {
+        int32_t primitives = __GLBJsonFind(&json, __GLBJsonItem(&json, meshes, m), "primitives");
+
+        for(uint32_t p = 0; p < __GLBJsonCount(&json, primitives); p++) {
+            GLBPrimitive_t* primitive = &pFile->mPrimitives[pFile->mPrimitiveCount];
+
+            if(!__GLBReadPrimitive(&json, 0, __GLBJsonItem(&json, primitives, p), pFile->mBinarySize, primitive)) {
+                E_WARN_ARG("Primitive %u of mesh %u in \"%s\" is not supported, it is skipped!", p, m, path);
+
+                continue;
+            }
+
+            primitive->mMesh = m;
+            pFile->mPrimitiveCount++;
+        }
+    }
+
+    MECFree(json.mTokens);
+
+    if(pFile->mPrimitiveCount == 0) {
+        E_WARN_ARG("\"%s\" has no drawable primitives!", path);
+
+        GLBClose(pFile);
+
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Copy accessor into packed float stream. Float accessors of same width are copied as whole block (or per element when interleaved), others are converted. Missing components get defaults
+ *
+ * @param pFile glb file pointer
+ * @param pAccessor accessor, missing one fills stream with defaults
+ * @param dst output stream
+ * @param components stream components
+ * @param count amount of elements
+ * @param defaults default components
+ */
+void __GLBReadStream(const GLBFile_t* pFile, const GLBAccessor_t* pAccessor, float* dst, uint32_t components, size_t count, const float* defaults) {
+    const uint8_t* src = pFile->mBinary + pAccessor->mOffset;
+
+    if(pAccessor->mCount == 0) {
+        for(size_t i = 0; i < count; i++) {
+            memcpy(&dst[i * components], defaults, sizeof(float) * components);
+        }
+
+        return;
+    }
+
+    if(pAccessor->mComponentType == GL_FLOAT && pAccessor->mComponents == components) {
+        if(pAccessor->mStride == sizeof(float) * components) {
+            memcpy(dst, src, sizeof(float) * components * count);
+
+            return;
+        }
+
+        for(size_t i = 0; i < count; i++) {
+            memcpy(&dst[i * components], src + i * pAccessor->mStride, sizeof(float) * components);
+        }
+
+        return;
+    }
+
+    PLYType_t type = __GLBComponentPLYType(pAccessor->mComponentType);
+    PFN_PLYReadValue read = PLYGetValueReader(type, PLY_HOST_BIG_ENDIAN);
+    uint32_t component_size = __GLBComponentSize(pAccessor->mComponentType);
+    float scale = pAccessor->mNormalized ? 1.0f / PLYTypeMaximum(type) : 1.0f;
+
+    for(size_t i = 0; i < count; i++) {
+        const uint8_t* element = src + i * pAccessor->mStride;
+
+        for(uint32_t c = 0; c < components; c++) {
+            float value = c < pAccessor->mComponents ? read(element + c * component_size) * scale : defaults[c];
+
+            dst[i * components + c] = value < -1.0f && pAccessor->mNormalized ? -1.0f : value;
+        }
+    }
+}
+
+/**
+ * @brief Load every triangle primitive of opened .glb file as own submesh of mesh data (node transforms are not applied). Indexed primitives stay indexed
+ *
+ * @param pFile opened glb file
+ * @param pData mesh data pointer
+ */
+void GLBLoadMeshData(const GLBFile_t* pFile, MeshData_t* pData) {
+    static const float defaults[4][4] = { {0.0f, 0.0f, 0.0f, 1.0f}, {1.0f, 1.0f, 1.0f, 1.0f}, {0.0f, 0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f, 0.0f} };
+    size_t vertex_count = pData->mJoinedMesh.mMeshSize;
+
+    for(uint32_t p = 0; p < pFile->mPrimitiveCount; p++) {
+        vertex_count += pFile->mPrimitives[p].mAttributes[0].mCount;
+    }
+
+    MDReserve(pData, pData->mMeshCount + pFile->mPrimitiveCount, vertex_count);
+
+    for(uint32_t p = 0; p < pFile->mPrimitiveCount; p++) {
+        const GLBPrimitive_t* primitive = &pFile->mPrimitives[p];
+        const GLBAccessor_t* indices = &primitive->mIndices;
+        size_t count = primitive->mAttributes[0].mCount;
+
+        if(primitive->mMode != GLB_MODE_TRIANGLES) {
+            E_WARN_ARG("Primitive %u is not triangle list, it is skipped!", p);
+
+            continue;
+        }
+
+        Mesh_t mesh;
+        MClearMesh(&mesh);
+        MAllocMesh(&mesh, count);
+
+        __GLBReadStream(pFile, &primitive->mAttributes[0], mesh.mVertices, 3, count, defaults[0]);
+        __GLBReadStream(pFile, &primitive->mAttributes[1], mesh.mColors, 4, count, defaults[1]);
+        __GLBReadStream(pFile, &primitive->mAttributes[2], mesh.mNormals, 3, count, defaults[2]);
+        __GLBReadStream(pFile, &primitive->mAttributes[3], mesh.mTextureCoordinates, 2, count, defaults[3]);
+
+        bool valid = true;
+
+        if(indices->mCount != 0) {
+            PLYType_t type = __GLBComponentPLYType(indices->mComponentType);
+            uint32_t index_size = __GLBComponentSize(indices->mComponentType);
+
+            MAllocIndices(&mesh, indices->mCount);
+
+            for(uint32_t i = 0; i < indices->mCount; i++) {
+                mesh.mIndices[i] = PLYReadIndex(pFile->mBinary + indices->mOffset + (size_t)i * index_size, type, false);
+                valid = valid && mesh.mIndices[i] < count;
+            }
+        }
+
+        if(!valid) {
+            E_WARN_ARG("Primitive %u has index out of its vertices, it is skipped!", p);
+
+            MFreeMesh(&mesh);
+
+            continue;
+        }
+
+        MCalculateBounds(&mesh);
+        MDAddMesh(pData, mesh);
+    }
+}
+
+/**
+ * @brief Upload BIN chunk of opened .glb file to render data as is and draw every primitive straight from it, accessors become vertex attribute formats and index buffers without any conversion. File can be closed afterwards
+ *
+ * @param pRd render data pointer
+ * @param pFile opened glb file
+ */
+void RDBindGLB(RenderData_t* pRd, const GLBFile_t* pFile) {
+    RDSourceDraw_t* draws = (RDSourceDraw_t*)MECCalloc(pFile->mPrimitiveCount, sizeof(RDSourceDraw_t));
+
+    for(uint32_t p = 0; p < pFile->mPrimitiveCount; p++) {
+        const GLBPrimitive_t* primitive = &pFile->mPrimitives[p];
+        RDSourceDraw_t* draw = &draws[p];
+
+        for(uint32_t i = 0; i < 4; i++) {
+            const GLBAccessor_t* accessor = &primitive->mAttributes[i];
+
+            if(accessor->mCount != 0) {
+                draw->mAttributes[i] = (RDSourceAttribute_t){ accessor->mOffset, accessor->mStride, accessor->mComponentType, accessor->mComponents, accessor->mNormalized };
+            }
+        }
+
+        draw->mMode = primitive->mMode;
+        draw->mIndexType = primitive->mIndices.mCount != 0 ? primitive->mIndices.mComponentType : 0;
+        draw->mIndexOffset = primitive->mIndices.mOffset;
+        draw->mCount = primitive->mIndices.mCount != 0 ? primitive->mIndices.mCount : primitive->mAttributes[0].mCount;
+    }
+
+    RDBindSource(pRd, pFile->mBinary, pFile->mBinarySize, draws, pFile->mPrimitiveCount);
+
+    MECFree(draws);
+}
+
+#endif
@@ -2,6 +2,20 @@
 #define _EFFECTIVE_MATH3D_
 
 #include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define MX_SIMD_X86
+#define MX_TARGET(isa) __attribute__((target(isa)))
+#elif defined(_MSC_VER) && defined(_M_X64)
+#include <immintrin.h>
+#include <intrin.h>
+#define MX_SIMD_X86
+#define MX_TARGET(isa)
+#endif
 
 typedef float real_t; 
 
@@ -303,6 +317,17 @@ mat4_t MX4LookAt(vec4_t eye, vec4_t at, vec4_t up) {
     }};
 }
 
+// planes (normal xyz, distance w) of view frustum of projection matrix in MX4MulV convention, point p is inside when dot(plane, p) >= 0 for all planes
+void MX4FrustumPlanes(mat4_t m, vec4_t planes[6]) {
+    for(int i = 0; i < 6; i++) {
+        real_t sign = i % 2 == 0 ? 1.0 : -1.0;
+        vec4_t row = (vec4_t){m.m[(i / 2) * 4 + 0], m.m[(i / 2) * 4 + 1], m.m[(i / 2) * 4 + 2], m.m[(i / 2) * 4 + 3]};
+        vec4_t plane = VAddV((vec4_t){m.m[12], m.m[13], m.m[14], m.m[15]}, VMulR(row, sign));
+
+        planes[i] = VDivR(plane, VLength((vec4_t){plane.x, plane.y, plane.z, 0.0}));
+    }
+}
+
 typedef struct Transform_s {
     vec4_t mPosition, mScale, mRotation;
     mat4_t mTransformMat;
@@ -330,4 +355,337 @@ void TFSetScale(Transform_t* pTrans, vec4_t v) {
     __TFRecalculateMatrix(pTrans);
 }
 
+typedef enum MXSimdLevel_e {
+    MX_SIMD_SCALAR,
+    MX_SIMD_SSE2,
+    MX_SIMD_AVX2,
+    MX_SIMD_AVX512,
+} MXSimdLevel_t;
+
+int gMXSimdLevel = -1;
+
+/**
+ * @brief Best instruction set supported by CPU and OS
+ * 
+ * @return MXSimdLevel_t 
+ */
+MXSimdLevel_t __MXDetectSimdLevel() {
+#if defined(MX_SIMD_X86) && defined(__GNUC__)
+    __builtin_cpu_init();
+
+    if(__builtin_cpu_supports("avx512f")) {
+        return MX_SIMD_AVX512;
+    }
+
+    if(__builtin_cpu_supports("avx2")) {
+        return MX_SIMD_AVX2;
+    }
+
+    return __builtin_cpu_supports("sse2") ? MX_SIMD_SSE2 : MX_SIMD_SCALAR;
+#elif defined(MX_SIMD_X86)
+    int info[4];
+    __cpuid(info, 0);
+    int max_leaf = info[0];
+
+    __cpuid(info, 1);
+    bool os_xsave = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0;
+    uint64_t xcr0 = os_xsave ? _xgetbv(0) : 0;
+
+    if(max_leaf < 7 || (xcr0 & 0x6) != 0x6) {
+        return MX_SIMD_SSE2;
+    }
+
+    __cpuidex(info, 7, 0);
+
+    if((info[1] & (1 << 16)) != 0 && (xcr0 & 0xe6) == 0xe6) {
+        return MX_SIMD_AVX512;
+    }
+
+    return (info[1] & (1 << 5)) != 0 ? MX_SIMD_AVX2 : MX_SIMD_SSE2;
+#else
+    return MX_SIMD_SCALAR;
+#endif
+}
+
+MXSimdLevel_t MXGetSimdLevel() {
+    if(gMXSimdLevel < 0) {
+        gMXSimdLevel = (int)__MXDetectSimdLevel();
+    }
+
+    return (MXSimdLevel_t)gMXSimdLevel;
+}
+
+/**
+ * @brief Limit instruction set used by batch transforms (e.g. to compare paths), levels above CPU support are clamped
+ * 
+ * @param level highest allowed level
+ */
+void MXSetSimdLevel(MXSimdLevel_t level) {
+    MXSimdLevel_t supported = __MXDetectSimdLevel();
+
+    gMXSimdLevel = (int)(level < supported ? level : supported);
+}
+
+/**
+ * @brief Lanes of register reg (of 3 registers holding width packed float3 values) which hold given component
+ * 
+ * @param width lanes in register
+ * @param reg register in block
+ * @param component 0 - x, 1 - y, 2 - z
+ * @return uint32_t lane bit mask
+ */
+uint32_t __MXLaneMask(uint32_t width, uint32_t reg, uint32_t component) {
+    uint32_t mask = 0;
+
+    for(uint32_t lane = 0; lane < width; lane++) {
+        mask |= (uint32_t)((reg * width + lane) % 3 == component) << lane;
+    }
+
+    return mask;
+}
+
+/**
+ * @brief Transforms packed float3 values by 3x4 row matrix, optionally normalizing results (zero vectors stay zero)
+ * 
+ * @param rows 3 rows of 4 floats, 4th column is added
+ * @param src source float3 values
+ * @param dst destination float3 values
+ * @param count amount of values
+ * @param normalize normalize results
+ */
+void __MXTransformScalar(const float* rows, const float* src, float* dst, size_t count, bool normalize) {
+    for(size_t i = 0; i < count; i++) {
+        float x = src[i * 3 + 0], y = src[i * 3 + 1], z = src[i * 3 + 2];
+        float result[3];
+
+        for(uint32_t r = 0; r < 3; r++) {
+            result[r] = rows[r * 4 + 0] * x + rows[r * 4 + 1] * y + rows[r * 4 + 2] * z + rows[r * 4 + 3];
+        }
+
+        float length = normalize ? sqrtf(result[0] * result[0] + result[1] * result[1] + result[2] * result[2]) : 1.0f;
+        float scale = length > 0.0f ? 1.0f / length : 0.0f;
+
+        for(uint32_t r = 0; r < 3; r++) {
+            dst[i * 3 + r] = result[r] * scale;
+        }
+    }
+}
+
+// SIMD kernels load W packed float3 values as 3 registers, transform them as x, y and z registers and store them packed again. Kernels return amount of transformed values, rest is left to __MXTransformScalar
+
+#ifdef MX_SIMD_X86
+MX_TARGET("sse2") size_t __MXTransformSSE2(const float* rows, const float* src, float* dst, size_t count, bool normalize) {
+    __m128 matrix[12];
+    size_t i = 0;
+
+    for(uint32_t m = 0; m < 12; m++) {
+        matrix[m] = _mm_set1_ps(rows[m]);
+    }
+
+    for(; i + 4 <= count; i += 4) {
+        // a = x0 y0 z0 x1, b = y1 z1 x2 y2, c = z2 x3 y3 z3
+        __m128 a = _mm_loadu_ps(&src[i * 3 + 0]), b = _mm_loadu_ps(&src[i * 3 + 4]), c = _mm_loadu_ps(&src[i * 3 + 8]);
+        __m128 x2y2x3y3 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 1, 3, 2));
+        __m128 y0z0y1z1 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 2, 1));
+        __m128 x = _mm_shuffle_ps(a, x2y2x3y3, _MM_SHUFFLE(2, 0, 3, 0));
+        __m128 y = _mm_shuffle_ps(y0z0y1z1, x2y2x3y3, _MM_SHUFFLE(3, 1, 2, 0));
+        __m128 z = _mm_shuffle_ps(y0z0y1z1, c, _MM_SHUFFLE(3, 0, 3, 1));
+        __m128 result[3];
+
+        for(uint32_t r = 0; r < 3; r++) {
+            result[r] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(matrix[r * 4 + 0], x), _mm_mul_ps(matrix[r * 4 + 1], y)), _mm_add_ps(_mm_mul_ps(matrix[r * 4 + 2], z), matrix[r * 4 + 3]));
+        }
+
+        if(normalize) {
+            __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(result[0], result[0]), _mm_mul_ps(result[1], result[1])), _mm_mul_ps(result[2], result[2])));
+            __m128 scale = _mm_and_ps(_mm_div_ps(_mm_set1_ps(1.0f), length), _mm_cmpgt_ps(length, _mm_setzero_ps()));
+
+            for(uint32_t r = 0; r < 3; r++) {
+                result[r] = _mm_mul_ps(result[r], scale);
+            }
+        }
+
+        x = result[0];
+        y = result[1];
+        z = result[2];
+
+        __m128 x0x1y0y1 = _mm_shuffle_ps(x, y, _MM_SHUFFLE(1, 0, 1, 0));
+        __m128 z0z2x1x3 = _mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 1, 2, 0));
+        __m128 y1y2z1z2 = _mm_shuffle_ps(y, z, _MM_SHUFFLE(2, 1, 2, 1));
+        __m128 x2x2y2y2 = _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2));
+        __m128 z2z2x3x3 = _mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2));
+        __m128 y3y3z3z3 = _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3));
+
+        _mm_storeu_ps(&dst[i * 3 + 0], _mm_shuffle_ps(x0x1y0y1, z0z2x1x3, _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(&dst[i * 3 + 4], _mm_shuffle_ps(y1y2z1z2, x2x2y2y2, _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(&dst[i * 3 + 8], _mm_shuffle_ps(z2z2x3x3, y3y3z3z3, _MM_SHUFFLE(2, 0, 2, 0)));
+    }
+
+    return i;
+}
+
+// wider registers are not split by shuffles. Component of lane L lies in exactly one of 3 registers, so x, y and z are blended lane wise (lanes then hold vertices in rotated order).
+// Blended y and z belong to vertices of x shifted by 1 and 2 lanes, they are rotated into place and rotated back before results are blended into packed registers by same lanes
+
+MX_TARGET("avx2") size_t __MXTransformAVX2(const float* rows, const float* src, float* dst, size_t count, bool normalize) {
+    __m256 matrix[12];
+    const __m256i rotate_1 = _mm256_set_epi32(0, 7, 6, 5, 4, 3, 2, 1), rotate_2 = _mm256_set_epi32(1, 0, 7, 6, 5, 4, 3, 2);
+    const __m256i rotate_back_1 = _mm256_set_epi32(6, 5, 4, 3, 2, 1, 0, 7), rotate_back_2 = _mm256_set_epi32(5, 4, 3, 2, 1, 0, 7, 6);
+    size_t i = 0;
+
+    for(uint32_t m = 0; m < 12; m++) {
+        matrix[m] = _mm256_set1_ps(rows[m]);
+    }
+
+    // lanes holding given component: 0x49 - lanes 0, 3, 6, 0x92 - lanes 1, 4, 7, 0x24 - lanes 2, 5
+    for(; i + 8 <= count; i += 8) {
+        __m256 a = _mm256_loadu_ps(&src[i * 3 + 0]), b = _mm256_loadu_ps(&src[i * 3 + 8]), c = _mm256_loadu_ps(&src[i * 3 + 16]);
+        __m256 x = _mm256_blend_ps(_mm256_blend_ps(a, b, 0x92), c, 0x24);
+        __m256 y = _mm256_permutevar8x32_ps(_mm256_blend_ps(_mm256_blend_ps(a, b, 0x24), c, 0x49), rotate_1);
+        __m256 z = _mm256_permutevar8x32_ps(_mm256_blend_ps(_mm256_blend_ps(a, b, 0x49), c, 0x92), rotate_2);
+        __m256 result[3];
+
+        for(uint32_t r = 0; r < 3; r++) {
+            result[r] = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(matrix[r * 4 + 0], x), _mm256_mul_ps(matrix[r * 4 + 1], y)), _mm256_add_ps(_mm256_mul_ps(matrix[r * 4 + 2], z), matrix[r * 4 + 3]));
+        }
+
+        if(normalize) {
+            __m256 length = _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(result[0], result[0]), _mm256_mul_ps(result[1], result[1])), _mm256_mul_ps(result[2], result[2])));
+            __m256 scale = _mm256_and_ps(_mm256_div_ps(_mm256_set1_ps(1.0f), length), _mm256_cmp_ps(length, _mm256_setzero_ps(), _CMP_GT_OQ));
+
+            for(uint32_t r = 0; r < 3; r++) {
+                result[r] = _mm256_mul_ps(result[r], scale);
+            }
+        }
+
+        x = result[0];
+        y = _mm256_permutevar8x32_ps(result[1], rotate_back_1);
+        z = _mm256_permutevar8x32_ps(result[2], rotate_back_2);
+
+        _mm256_storeu_ps(&dst[i * 3 + 0], _mm256_blend_ps(_mm256_blend_ps(x, y, 0x92), z, 0x24));
+        _mm256_storeu_ps(&dst[i * 3 + 8], _mm256_blend_ps(_mm256_blend_ps(x, y, 0x24), z, 0x49));
+        _mm256_storeu_ps(&dst[i * 3 + 16], _mm256_blend_ps(_mm256_blend_ps(x, y, 0x49), z, 0x92));
+    }
+
+    return i;
+}
+
+MX_TARGET("avx512f") __m512 __MXSelectAVX512(__m512 a, __m512 b, __m512 c, const __mmask16* masks) {
+    return _mm512_mask_blend_ps(masks[2], _mm512_mask_blend_ps(masks[1], a, b), c);
+}
+
+MX_TARGET("avx512f") size_t __MXTransformAVX512(const float* rows, const float* src, float* dst, size_t count, bool normalize) {
+    __mmask16 masks[3][3];
+    __m512 matrix[12];
+    const __m512i rotate_1 = _mm512_set_epi32(0, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1), rotate_2 = _mm512_set_epi32(1, 0, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2);
+    const __m512i rotate_back_1 = _mm512_set_epi32(14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 15), rotate_back_2 = _mm512_set_epi32(13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 15, 14);
+    size_t i = 0;
+
+    for(uint32_t r = 0; r < 3; r++) {
+        for(uint32_t c = 0; c < 3; c++) {
+            masks[c][r] = (__mmask16)__MXLaneMask(16, r, c);
+        }
+    }
+
+    for(uint32_t m = 0; m < 12; m++) {
+        matrix[m] = _mm512_set1_ps(rows[m]);
+    }
+
+    for(; i + 16 <= count; i += 16) {
+        __m512 a = _mm512_loadu_ps(&src[i * 3 + 0]), b = _mm512_loadu_ps(&src[i * 3 + 16]), c = _mm512_loadu_ps(&src[i * 3 + 32]);
+        __m512 x = __MXSelectAVX512(a, b, c, masks[0]);
+        __m512 y = _mm512_permutexvar_ps(rotate_1, __MXSelectAVX512(a, b, c, masks[1]));
+        __m512 z = _mm512_permutexvar_ps(rotate_2, __MXSelectAVX512(a, b, c, masks[2]));
+        __m512 result[3];
+
+        for(uint32_t r = 0; r < 3; r++) {
+            result[r] = _mm512_fmadd_ps(matrix[r * 4 + 0], x, _mm512_fmadd_ps(matrix[r * 4 + 1], y, _mm512_fmadd_ps(matrix[r * 4 + 2], z, matrix[r * 4 + 3])));
+        }
+
+        if(normalize) {
+            __m512 length = _mm512_sqrt_ps(_mm512_fmadd_ps(result[0], result[0], _mm512_fmadd_ps(result[1], result[1], _mm512_mul_ps(result[2], result[2]))));
+            __m512 scale = _mm512_maskz_div_ps(_mm512_cmp_ps_mask(length, _mm512_setzero_ps(), _CMP_GT_OQ), _mm512_set1_ps(1.0f), length);
+
+            for(uint32_t r = 0; r < 3; r++) {
+                result[r] = _mm512_mul_ps(result[r], scale);
+            }
+        }
+
+        result[1] = _mm512_permutexvar_ps(rotate_back_1, result[1]);
+        result[2] = _mm512_permutexvar_ps(rotate_back_2, result[2]);
+
+        for(uint32_t r = 0; r < 3; r++) {
+            __mmask16 reg_masks[3] = { masks[0][r], masks[1][r], masks[2][r] };
+
+            _mm512_storeu_ps(&dst[i * 3 + r * 16], __MXSelectAVX512(result[0], result[1], result[2], reg_masks));
+        }
+    }
+
+    return i;
+}
+#endif
+
+/**
+ * @brief Transforms packed float3 values with best kernel allowed by MXGetSimdLevel
+ * 
+ * @param rows 3 rows of 4 floats, 4th column is added
+ * @param src source float3 values
+ * @param dst destination float3 values (may be src)
+ * @param count amount of values
+ * @param normalize normalize results
+ */
+void __MXTransform(const float* rows, const float* src, float* dst, size_t count, bool normalize) {
+    size_t done = 0;
+
+#ifdef MX_SIMD_X86
+    switch(MXGetSimdLevel()) {
+        case MX_SIMD_AVX512: done = __MXTransformAVX512(rows, src, dst, count, normalize); break;
+        case MX_SIMD_AVX2: done = __MXTransformAVX2(rows, src, dst, count, normalize); break;
+        case MX_SIMD_SSE2: done = __MXTransformSSE2(rows, src, dst, count, normalize); break;
+        default: break;
+    }
+#endif
+
+    __MXTransformScalar(rows, &src[done * 3], &dst[done * 3], count - done, normalize);
+}
+
+/**
+ * @brief Transform packed float3 positions (e.g. Mesh_t mVertices) by matrix (same result as MX4MulV with w = 1, without perspective divide). SSE2, AVX2 or AVX-512 kernel is picked at runtime
+ * 
+ * @param m transform matrix
+ * @param src source positions
+ * @param dst destination positions (may be src)
+ * @param count amount of positions
+ */
+void MX4TransformPoints(mat4_t m, const float* src, float* dst, size_t count) {
+    __MXTransform(m.m, src, dst, count, false);
+}
+
+/**
+ * @brief Transform packed float3 normals by inverse transpose of matrix upper 3x3 and normalize them, so normals stay perpendicular under non uniform scale. Zero normals stay zero
+ * 
+ * @param m transform matrix (of positions)
+ * @param src source normals
+ * @param dst destination normals (may be src)
+ * @param count amount of normals
+ */
+void MX4TransformNormals(mat4_t m, const float* src, float* dst, size_t count) {
+    // rows of inverse transpose are cross products of matrix rows divided by determinant
+    const float* a = &m.m[0];
+    const float* b = &m.m[4];
+    const float* c = &m.m[8];
+    float rows[12] = {
+        b[1] * c[2] - b[2] * c[1], b[2] * c[0] - b[0] * c[2], b[0] * c[1] - b[1] * c[0], 0.0f,
+        c[1] * a[2] - c[2] * a[1], c[2] * a[0] - c[0] * a[2], c[0] * a[1] - c[1] * a[0], 0.0f,
+        a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0], 0.0f,
+    };
+    float determinant = a[0] * rows[0] + a[1] * rows[1] + a[2] * rows[2];
+
+    for(uint32_t i = 0; i < 12 && determinant < 0.0f; i++) {
+        rows[i] = -rows[i];
+    }
+
+    __MXTransform(rows, src, dst, count, true);
+}
+
 #endif
\ No newline at end of file
@@ -1,9 +1,35 @@
 #ifndef _EFFECTIVE_MESH_
 #define _EFFECTIVE_MESH_
 
+#include <float.h>
 #include "gl_buffers.h"
 #include "math3d.h"
 #include "core.h"
+#include "ply.h"
+#include "multithreader.h"
+
+#define M_MAX_LODS 8
+
+/**
+ * @brief Level of detail as index range of mesh index buffer, error is object space distance simplified surface deviates from full mesh
+ */
+typedef struct MeshLod_s {
+    size_t mIndexOffset;
+    size_t mIndexCount;
+    float mError;
+} MeshLod_t;
+
+/**
+ * @brief Cluster of neighbouring triangles as index range of full mesh, with bounding sphere and normal cone for culling (cone cutoff 1 with zero axis is never back facing)
+ */
+typedef struct Meshlet_s {
+    uint32_t mIndexOffset;
+    uint32_t mIndexCount;
+    float mCenter[3];
+    float mRadius;
+    float mConeAxis[3];
+    float mConeCutoff;
+} Meshlet_t;
 
 typedef struct Mesh_s {
     float* mVertices;
@@ -11,566 +37,3442 @@ typedef struct Mesh_s {
     float* mTextureCoordinates;
     float* mColors;
     size_t mMeshSize;
+    size_t mMeshCapacity;
+
+    uint32_t* mIndices;
+    size_t mIndexCount;
+    size_t mIndexCapacity;
+
+    float mBoundsMin[3];
+    float mBoundsMax[3];
+
+    // level 0 is [0, mIndexCount), coarser levels are stored contiguously right after it (see MOGenerateLods)
+    MeshLod_t mLods[M_MAX_LODS];
+    uint32_t mLodCount;
+
+    // clusters of full mesh triangles (see MOBuildMeshlets)
+    Meshlet_t* mMeshlets;
+    uint32_t mMeshletCount;
 } Mesh_t;
 
+/**
+ * @brief Reserve memory for at least capacity vertices in every mesh stream, mesh size is not changed
+ * 
+ * @param pMesh mesh pointer
+ * @param capacity vertex capacity
+ */
+void MReserveMesh(Mesh_t* pMesh, size_t capacity) {
+    if(capacity <= pMesh->mMeshCapacity) {
+        return;
+    }
+
+    pMesh->mMeshCapacity = capacity;
+
+    pMesh->mVertices = (float*)MECRealloc(pMesh->mVertices, pMesh->mMeshCapacity * sizeof(float) * 3);
+    pMesh->mNormals = (float*)MECRealloc(pMesh->mNormals, pMesh->mMeshCapacity * sizeof(float) * 3);
+    pMesh->mTextureCoordinates = (float*)MECRealloc(pMesh->mTextureCoordinates, pMesh->mMeshCapacity * sizeof(float) * 2);
+    pMesh->mColors = (float*)MECRealloc(pMesh->mColors, pMesh->mMeshCapacity * sizeof(float) * 4);
+}
+
+/**
+ * @brief Resize mesh, capacity grows geometrically so appending vertices is amortized constant time
+ * 
+ * @param pMesh mesh pointer
+ * @param size new vertex count
+ */
 void MAllocMesh(Mesh_t* pMesh, size_t size) {
+    if(size > pMesh->mMeshCapacity) {
+        size_t capacity = pMesh->mMeshCapacity + pMesh->mMeshCapacity / 2;
+
+        MReserveMesh(pMesh, capacity > size ? capacity : size);
+    }
+
     pMesh->mMeshSize = size;
+}
+
+/**
+ * @brief Reserve memory for at least capacity indices, index count is not changed
+ * 
+ * @param pMesh mesh pointer
+ * @param capacity index capacity
+ */
+void MReserveIndices(Mesh_t* pMesh, size_t capacity) {
+    if(capacity <= pMesh->mIndexCapacity) {
+        return;
+    }
+
+    pMesh->mIndexCapacity = capacity;
+    pMesh->mIndices = (uint32_t*)MECRealloc(pMesh->mIndices, pMesh->mIndexCapacity * sizeof(uint32_t));
+}
+
+/**
+ * @brief Resize mesh index buffer, grows geometrically like MAllocMesh. Mesh with index count other than 0 is drawn as indexed triangles. LOD levels stored after indices and meshlets are dropped
+ * 
+ * @param pMesh mesh pointer
+ * @param count new index count
+ */
+void MAllocIndices(Mesh_t* pMesh, size_t count) {
+    if(count > pMesh->mIndexCapacity) {
+        size_t capacity = pMesh->mIndexCapacity + pMesh->mIndexCapacity / 2;
+
+        MReserveIndices(pMesh, capacity > count ? capacity : count);
+    }
+
+    pMesh->mIndexCount = count;
+    pMesh->mLodCount = 0;
+    pMesh->mMeshletCount = 0;
+}
+
+/**
+ * @brief End of indices stored in mesh index buffer, including all LOD levels
+ * 
+ * @param pMesh mesh pointer
+ * @return size_t 
+ */
+size_t MLodIndexEnd(const Mesh_t* pMesh) {
+    if(pMesh->mLodCount == 0) {
+        return pMesh->mIndexCount;
+    }
 
-    pMesh->mVertices = (float*)MECRealloc(pMesh->mVertices, pMesh->mMeshSize * sizeof(float) * 3);
-    pMesh->mNormals = (float*)MECRealloc(pMesh->mNormals, pMesh->mMeshSize * sizeof(float) * 3);
-    pMesh->mTextureCoordinates = (float*)MECRealloc(pMesh->mTextureCoordinates, pMesh->mMeshSize * sizeof(float) * 2);
-    pMesh->mColors = (float*)MECRealloc(pMesh->mColors, pMesh->mMeshSize * sizeof(float) * 4);
+    return pMesh->mLods[pMesh->mLodCount - 1].mIndexOffset + pMesh->mLods[pMesh->mLodCount - 1].mIndexCount;
 }
 
 void MFreeMesh(Mesh_t* pMesh) {
     pMesh->mMeshSize = 0;
+    pMesh->mMeshCapacity = 0;
 
     MECFree(pMesh->mVertices);
     MECFree(pMesh->mNormals);
     MECFree(pMesh->mTextureCoordinates);
     MECFree(pMesh->mColors);
+
+    if(pMesh->mIndices != nullptr) {
+        MECFree(pMesh->mIndices);
+    }
+
+    if(pMesh->mMeshlets != nullptr) {
+        MECFree(pMesh->mMeshlets);
+    }
+
+    pMesh->mVertices = nullptr;
+    pMesh->mNormals = nullptr;
+    pMesh->mTextureCoordinates = nullptr;
+    pMesh->mColors = nullptr;
+    pMesh->mIndices = nullptr;
+    pMesh->mIndexCount = 0;
+    pMesh->mIndexCapacity = 0;
+    pMesh->mLodCount = 0;
+    pMesh->mMeshlets = nullptr;
+    pMesh->mMeshletCount = 0;
 }
 
 void MClearMesh(Mesh_t* pMesh) {
     pMesh->mMeshSize = 0;
+    pMesh->mMeshCapacity = 0;
 
     pMesh->mVertices = nullptr;
     pMesh->mNormals = nullptr;
     pMesh->mTextureCoordinates = nullptr;
     pMesh->mColors = nullptr;
+
+    pMesh->mIndices = nullptr;
+    pMesh->mIndexCount = 0;
+    pMesh->mIndexCapacity = 0;
+
+    memset(pMesh->mBoundsMin, 0, sizeof(pMesh->mBoundsMin));
+    memset(pMesh->mBoundsMax, 0, sizeof(pMesh->mBoundsMax));
+    memset(pMesh->mLods, 0, sizeof(pMesh->mLods));
+    pMesh->mLodCount = 0;
+    pMesh->mMeshlets = nullptr;
+    pMesh->mMeshletCount = 0;
 }
 
-void MLoadPLYMeshFromFile(Mesh_t* pMesh, const char* path) {
-    FILE* mesh_file = fopen(path, "rb+");
+/**
+ * @brief Calculate axis aligned bounding box of mesh vertices, empty mesh gets zero bounds
+ * 
+ * @param pMesh mesh pointer
+ */
+void MCalculateBounds(Mesh_t* pMesh) {
+    if(pMesh->mMeshSize == 0) {
+        memset(pMesh->mBoundsMin, 0, sizeof(pMesh->mBoundsMin));
+        memset(pMesh->mBoundsMax, 0, sizeof(pMesh->mBoundsMax));
+
+        return;
+    }
 
-    fseek(mesh_file, 0, SEEK_END);
-    size_t mesh_length = ftell(mesh_file);
-    fseek(mesh_file, 0, SEEK_SET);
+    for(uint32_t c = 0; c < 3; c++) {
+        pMesh->mBoundsMin[c] = pMesh->mVertices[c];
+        pMesh->mBoundsMax[c] = pMesh->mVertices[c];
+    }
 
+    for(size_t i = 1; i < pMesh->mMeshSize; i++) {
+        for(uint32_t c = 0; c < 3; c++) {
+            float value = pMesh->mVertices[i * 3 + c];
 
-    uint8_t *source_buffer = nullptr;
-    source_buffer = (uint8_t*)MECCalloc(mesh_length, sizeof(uint8_t));
+            pMesh->mBoundsMin[c] = value < pMesh->mBoundsMin[c] ? value : pMesh->mBoundsMin[c];
+            pMesh->mBoundsMax[c] = value > pMesh->mBoundsMax[c] ? value : pMesh->mBoundsMax[c];
+        }
+    }
+}
 
-    fread(source_buffer, sizeof(uint8_t), mesh_length, mesh_file);
+/**
+ * @brief Append vertices and indices of other mesh, indices are rebased onto first appended vertex and bounds are merged. LOD levels and meshlets are kept only when appending into empty mesh
+ * 
+ * @param pMesh mesh pointer
+ * @param pSrc appended mesh
+ */
+void MAppendMesh(Mesh_t* pMesh, const Mesh_t* pSrc) {
+    size_t first = pMesh->mMeshSize;
+    size_t first_index = pMesh->mIndexCount;
+
+    if(pSrc->mMeshSize != 0) {
+        MAllocMesh(pMesh, first + pSrc->mMeshSize);
+
+        memcpy(&pMesh->mVertices[first * 3], pSrc->mVertices, sizeof(float) * 3 * pSrc->mMeshSize);
+        memcpy(&pMesh->mNormals[first * 3], pSrc->mNormals, sizeof(float) * 3 * pSrc->mMeshSize);
+        memcpy(&pMesh->mTextureCoordinates[first * 2], pSrc->mTextureCoordinates, sizeof(float) * 2 * pSrc->mMeshSize);
+        memcpy(&pMesh->mColors[first * 4], pSrc->mColors, sizeof(float) * 4 * pSrc->mMeshSize);
+    }
 
-    if(source_buffer[0] != 'p' && source_buffer[1] != 'l' && source_buffer[2] != 'y') {
-        fclose(mesh_file);
+    if(pSrc->mIndexCount != 0) {
+        size_t count = first == 0 && first_index == 0 ? MLodIndexEnd(pSrc) : pSrc->mIndexCount;
 
-        char warn_string[1024] = "Cannot load model \"";
-        strcat(warn_string, path);
-        strcat(warn_string, "\" becouse it`s not ply model!");
+        MAllocIndices(pMesh, first_index + pSrc->mIndexCount);
+        MReserveIndices(pMesh, first_index + count);
 
-        E_WARN(warn_string);
+        for(size_t i = 0; i < count; i++) {
+            pMesh->mIndices[first_index + i] = pSrc->mIndices[i] + (uint32_t)first;
+        }
 
-        MECFree(source_buffer);
+        if(count != pSrc->mIndexCount) {
+            memcpy(pMesh->mLods, pSrc->mLods, sizeof(pMesh->mLods));
+            pMesh->mLodCount = pSrc->mLodCount;
+        }
 
-        return;
+        if(first == 0 && first_index == 0 && pSrc->mMeshletCount != 0) {
+            pMesh->mMeshlets = MECRealloc(pMesh->mMeshlets, sizeof(Meshlet_t) * pSrc->mMeshletCount);
+            pMesh->mMeshletCount = pSrc->mMeshletCount;
+
+            memcpy(pMesh->mMeshlets, pSrc->mMeshlets, sizeof(Meshlet_t) * pSrc->mMeshletCount);
+        }
+    }
+
+    for(uint32_t c = 0; c < 3; c++) {
+        pMesh->mBoundsMin[c] = first != 0 && pMesh->mBoundsMin[c] < pSrc->mBoundsMin[c] ? pMesh->mBoundsMin[c] : pSrc->mBoundsMin[c];
+        pMesh->mBoundsMax[c] = first != 0 && pMesh->mBoundsMax[c] > pSrc->mBoundsMax[c] ? pMesh->mBoundsMax[c] : pSrc->mBoundsMax[c];
     }
+}
+
+/**
+ * @brief Quantized vertex (16 bytes): position as 16 bit fractions of bounds, octahedral 8 bit normal, half float texture coordinates and RGBA8 color
+ */
+typedef struct CompactVertex_s {
+    uint16_t mPosition[3];
+    int8_t mNormal[2];
+    uint16_t mTextureCoordinates[2];
+    uint8_t mColor[4];
+} CompactVertex_t;
+
+/**
+ * @brief Quantizes float in [-1, 1] to signed 8 bit
+ */
+int8_t __MQuantizeSnorm8(float value) {
+    value = value < -1.0f ? -1.0f : (value > 1.0f ? 1.0f : value);
+
+    return (int8_t)lroundf(value * 127.0f);
+}
 
-    size_t header_end = SFindInString_Slow((uint8_t*)"end_header", source_buffer) + 11;
-    size_t vertex_element = SFindInString_Slow((uint8_t*)"element vertex ", source_buffer) + 15;
-    size_t face_element = SFindInString_Slow((uint8_t*)"element face ", source_buffer) + 13;
-    size_t format_ascii = SFindInString_Slow((uint8_t*)"format ascii 1.0", source_buffer);
-    if(format_ascii == SIZE_MAX) { E_INFO("Ignore upper warning, it pops when binary format of .ply is used!") }
-    size_t prop_vertices = SFindInString_Slow((uint8_t*)"property float x\n", source_buffer);
-    size_t prop_normals = SFindInString_Slow((uint8_t*)"property float nx\n", source_buffer);
-    if(prop_normals == SIZE_MAX) { E_INFO("Ignore upper warning, it pops when there is no normals data generated in .ply file!") }
-    size_t prop_texturepos = SFindInString_Slow((uint8_t*)"property float s\n", source_buffer);
-    if(prop_texturepos == SIZE_MAX) { E_INFO("Ignore upper warning, it pops when there is no texure data generated in .ply file!") }
+/**
+ * @brief Octahedral projection of normal to [-1, 1] square
+ * 
+ * @param normal normal (3 floats)
+ * @param encoded output x and y
+ */
+void __MOctahedralEncode(const float* normal, float* encoded) {
+    float length = fabsf(normal[0]) + fabsf(normal[1]) + fabsf(normal[2]);
+    float x = length > 0.0f ? normal[0] / length : 0.0f;
+    float y = length > 0.0f ? normal[1] / length : 0.0f;
+
+    if(normal[2] < 0.0f) {
+        float folded_x = (1.0f - fabsf(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+        float folded_y = (1.0f - fabsf(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+
+        x = folded_x;
+        y = folded_y;
+    }
 
-    char numbers_buffer[1024];
+    encoded[0] = x;
+    encoded[1] = y;
+}
 
-    MECCopyMemoryUntil(numbers_buffer, source_buffer + vertex_element, 256, '\n');
-    uint32_t vertex_amount = atoi(numbers_buffer);
+/**
+ * @brief Encode mesh vertices [first, first + count) into compact vertices, positions are quantized inside given bounds
+ * 
+ * @param pMesh mesh pointer
+ * @param boundsMin quantization bounds minimum
+ * @param boundsMax quantization bounds maximum
+ * @param first first vertex
+ * @param count vertices amount
+ * @param dst output compact vertices
+ */
+void MEncodeCompactVertices(const Mesh_t* pMesh, const float* boundsMin, const float* boundsMax, size_t first, size_t count, CompactVertex_t* dst) {
+    float scale[3];
+
+    for(uint32_t c = 0; c < 3; c++) {
+        scale[c] = boundsMax[c] > boundsMin[c] ? 65535.0f / (boundsMax[c] - boundsMin[c]) : 0.0f;
+    }
 
-    memset(numbers_buffer, 0, 1024);
-    MECCopyMemoryUntil(numbers_buffer, source_buffer + face_element, 256, '\n');
-    uint32_t face_amount = atoi(numbers_buffer);
+    for(size_t i = 0; i < count; i++) {
+        const float* position = &pMesh->mVertices[(first + i) * 3];
+        const float* normal = &pMesh->mNormals[(first + i) * 3];
+        const float* texture_coordinates = &pMesh->mTextureCoordinates[(first + i) * 2];
+        const float* color = &pMesh->mColors[(first + i) * 4];
 
-    E_INFO_ARG("Model data: %u vertex, %u faces", vertex_amount, face_amount);
+        for(uint32_t c = 0; c < 3; c++) {
+            float quantized = (position[c] - boundsMin[c]) * scale[c] + 0.5f;
 
-    fseek(mesh_file, 0, SEEK_SET);
+            dst[i].mPosition[c] = (uint16_t)(quantized < 0.0f ? 0.0f : (quantized > 65535.0f ? 65535.0f : quantized));
+        }
 
-    char *line = nullptr; 
-    line = (char*)MECCalloc(mesh_length, sizeof(char));
-    uint32_t vertex_counter = 0;
-    uint32_t face_counter = 0;
+        float octahedral[2];
+        __MOctahedralEncode(normal, octahedral);
 
-    Mesh_t temp;
-    size_t mv_counter = 0;
-    size_t mn_counter = 0;
-    size_t mt_counter = 0;
-    MClearMesh(&temp);
+        dst[i].mNormal[0] = __MQuantizeSnorm8(octahedral[0]);
+        dst[i].mNormal[1] = __MQuantizeSnorm8(octahedral[1]);
 
-    MAllocMesh(&temp, vertex_amount);
+        dst[i].mTextureCoordinates[0] = CFloatToHalf(texture_coordinates[0]);
+        dst[i].mTextureCoordinates[1] = CFloatToHalf(texture_coordinates[1]);
 
-    while(!feof(mesh_file)) {
-        uint8_t ch = 0;
+        for(uint32_t c = 0; c < 4; c++) {
+            float value = color[c] < 0.0f ? 0.0f : (color[c] > 1.0f ? 1.0f : color[c]);
 
-        if(format_ascii != SIZE_MAX){
-            fgets(line, (size_t)mesh_length, mesh_file);
+            dst[i].mColor[c] = (uint8_t)(value * 255.0f + 0.5f);
         }
-        else {
-            ch = fgetc(mesh_file);
-        }
-
-        if(ftell(mesh_file) > (long)header_end) {
-            if(format_ascii != SIZE_MAX) {
-                if(strcmp(line, "end_header\n") == 0) { continue; }
-
-                if(vertex_counter < vertex_amount) {
-                    char number[256];
-                    size_t current_pos = 0;
-                    
-                    if(prop_vertices != SIZE_MAX) {
-                        current_pos += CopyNumber(number, line + current_pos, 256, ' ');
-                        temp.mVertices[mv_counter++] = atof(number);
-                        current_pos += CopyNumber(number, line + current_pos, 256, ' ');
-                        temp.mVertices[mv_counter++] = atof(number);
-                        current_pos += CopyNumber(number, line + current_pos, 256, ' ');
-                        temp.mVertices[mv_counter++] = atof(number);
-                    }
+    }
+}
 
-                    if(prop_normals != SIZE_MAX) {
-                        current_pos += CopyNumber(number, line + current_pos, 256, ' ');
-                        temp.mNormals[mn_counter++] = atof(number);
-                        current_pos += CopyNumber(number, line + current_pos, 256, ' ');
-                        temp.mNormals[mn_counter++] = atof(number);
-                        current_pos += CopyNumber(number, line + current_pos, 256, ' ');
-                        temp.mNormals[mn_counter++] = atof(number);
-                    }
+/**
+ * @brief Float stream of mesh for shader location (0 - positions, 1 - colors, 2 - normals, 3 - texture coordinates, 4 - texture IDs, 5 - mesh IDs)
+ * 
+ * @param pMesh mesh pointer
+ * @param textureIDs texture ID of every vertex
+ * @param meshIDs submesh index of every vertex
+ * @param location shader location
+ * @param pDimmensions output floats per vertex
+ * @return const float* 
+ */
+const float* __MVertexStream(const Mesh_t* pMesh, const float* textureIDs, const float* meshIDs, uint32_t location, uint32_t* pDimmensions) {
+    switch(location) {
+        case 0: *pDimmensions = 3; return pMesh->mVertices;
+        case 1: *pDimmensions = 4; return pMesh->mColors;
+        case 2: *pDimmensions = 3; return pMesh->mNormals;
+        case 3: *pDimmensions = 2; return pMesh->mTextureCoordinates;
+        case 4: *pDimmensions = 1; return textureIDs;
+        default: *pDimmensions = 1; return meshIDs;
+    }
+}
 
-                    if(prop_texturepos != SIZE_MAX) {
-                        current_pos += CopyNumber(number, line + current_pos, 256, ' ');
-                        temp.mTextureCoordinates[mt_counter++] = atof(number);
-                        current_pos += CopyNumber(number, line + current_pos, 256, '\n');
-                        temp.mTextureCoordinates[mt_counter++] = atof(number);
-                    }
+/**
+ * @brief Converts components to attribute type, integer types are clamped to their range
+ * 
+ * @param dst attribute place in stream vertex (don`t need to be aligned)
+ * @param values components
+ * @param pAttribute attribute
+ */
+void __MWriteComponents(uint8_t* dst, const float* values, const VertexAttribute_t* pAttribute) {
+    bool normalized = pAttribute->mNormalized;
+
+    for(uint32_t c = 0; c < pAttribute->mDimmensions; c++) {
+        float value = values[c];
+
+        switch(pAttribute->mType) {
+            case GL_FLOAT: {
+                memcpy(&dst[c * 4], &value, sizeof(float));
+            } break;
+            case GL_HALF_FLOAT: {
+                uint16_t half = CFloatToHalf(value);
+                memcpy(&dst[c * 2], &half, sizeof(uint16_t));
+            } break;
+            case GL_UNSIGNED_BYTE: {
+                value = normalized ? value * 255.0f + 0.5f : roundf(value);
+                dst[c] = (uint8_t)(value < 0.0f ? 0.0f : (value > 255.0f ? 255.0f : value));
+            } break;
+            case GL_BYTE: {
+                value = roundf(value);
+                dst[c] = normalized ? (uint8_t)__MQuantizeSnorm8(values[c]) : (uint8_t)(int8_t)(value < -128.0f ? -128.0f : (value > 127.0f ? 127.0f : value));
+            } break;
+            case GL_UNSIGNED_SHORT: {
+                value = normalized ? value * 65535.0f + 0.5f : roundf(value);
+                uint16_t word = (uint16_t)(value < 0.0f ? 0.0f : (value > 65535.0f ? 65535.0f : value));
+                memcpy(&dst[c * 2], &word, sizeof(uint16_t));
+            } break;
+            default: {
+                value = normalized ? roundf((value < -1.0f ? -1.0f : (value > 1.0f ? 1.0f : value)) * 32767.0f) : roundf(value);
+                int16_t word = (int16_t)(value < -32768.0f ? -32768.0f : (value > 32767.0f ? 32767.0f : value));
+                memcpy(&dst[c * 2], &word, sizeof(int16_t));
+            } break;
+        }
+    }
+}
 
-                    vertex_counter++;
+/**
+ * @brief Encode mesh vertices [first, first + count) into one stream of vertex format. Positions of integer type are quantized inside given bounds (decoded by uPositionOffset/uPositionScale), 2 component normals are octahedral
+ * 
+ * @param pMesh mesh pointer
+ * @param textureIDs texture ID of every vertex (shader location 4)
+ * @param meshIDs submesh index of every vertex (shader location 5)
+ * @param pFormat vertex format
+ * @param stream encoded stream
+ * @param boundsMin quantization bounds minimum
+ * @param boundsMax quantization bounds maximum
+ * @param first first vertex
+ * @param count vertices amount
+ * @param dst output, count * stream stride bytes
+ */
+void MEncodeVertexStream(const Mesh_t* pMesh, const float* textureIDs, const float* meshIDs, const VertexFormat_t* pFormat, uint32_t stream, const float* boundsMin, const float* boundsMax, size_t first, size_t count, void* dst) {
+    uint8_t* bytes = (uint8_t*)dst;
+    uint32_t stride = pFormat->mStrides[stream];
+
+    for(uint32_t location = 0; location < VF_MAX_ATTRIBUTES; location++) {
+        const VertexAttribute_t* attribute = &pFormat->mAttributes[location];
+        uint32_t dimmensions = 0;
+        const float* source = __MVertexStream(pMesh, textureIDs, meshIDs, location, &dimmensions);
+        bool quantized = location == 0 && attribute->mType != GL_FLOAT && attribute->mType != GL_HALF_FLOAT;
+        bool octahedral = location == 2 && attribute->mDimmensions == 2;
+        float scale[3];
+
+        if(attribute->mDimmensions == 0 || attribute->mStream != stream) {
+            continue;
+        }
 
-                    continue;
+        for(uint32_t c = 0; c < 3; c++) {
+            scale[c] = boundsMax[c] > boundsMin[c] ? 1.0f / (boundsMax[c] - boundsMin[c]) : 0.0f;
+        }
+
+        for(size_t i = 0; i < count; i++) {
+            const float* vertex = &source[(first + i) * dimmensions];
+            float values[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+
+            memcpy(values, vertex, sizeof(float) * dimmensions);
+
+            if(octahedral) {
+                __MOctahedralEncode(vertex, values);
+            }
+            else if(quantized) {
+                for(uint32_t c = 0; c < 3; c++) {
+                    values[c] = (vertex[c] - boundsMin[c]) * scale[c];
                 }
-                
-                if(face_counter < face_amount) {
-                    char number[256];
-                    size_t current_pos = 0;
-
-                    current_pos += CopyNumber(number, line + current_pos, 256, ' ');
-                    int faces_value_amount = atoi(number);
-
-                    if(faces_value_amount == 4) {
-                        uint32_t face[4] = {0, 0, 0, 0};
-
-                        current_pos += CopyNumber(number, line + current_pos, 256, ' ');
-                        face[0] = atoi(number);
-                        current_pos += CopyNumber(number, line + current_pos, 256, ' ');
-                        face[1] = atoi(number);
-                        current_pos += CopyNumber(number, line + current_pos, 256, ' ');
-                        face[2] = atoi(number);
-                        current_pos += CopyNumber(number, line + current_pos, 256, '\n');
-                        face[3] = atoi(number);
-
-                        MAllocMesh(pMesh, pMesh->mMeshSize + 6);
-
-                        pMesh->mVertices[(pMesh->mMeshSize - 6) * 3 + 0] = temp.mVertices[face[0] * 3 + 0];
-                        pMesh->mVertices[(pMesh->mMeshSize - 6) * 3 + 1] = temp.mVertices[face[0] * 3 + 1];
-                        pMesh->mVertices[(pMesh->mMeshSize - 6) * 3 + 2] = temp.mVertices[face[0] * 3 + 2];
-                    
-                        pMesh->mVertices[(pMesh->mMeshSize - 5) * 3 + 0] = temp.mVertices[face[1] * 3 + 0];
-                        pMesh->mVertices[(pMesh->mMeshSize - 5) * 3 + 1] = temp.mVertices[face[1] * 3 + 1];
-                        pMesh->mVertices[(pMesh->mMeshSize - 5) * 3 + 2] = temp.mVertices[face[1] * 3 + 2];
-
-                        pMesh->mVertices[(pMesh->mMeshSize - 4) * 3 + 0] = temp.mVertices[face[2] * 3 + 0];
-                        pMesh->mVertices[(pMesh->mMeshSize - 4) * 3 + 1] = temp.mVertices[face[2] * 3 + 1];
-                        pMesh->mVertices[(pMesh->mMeshSize - 4) * 3 + 2] = temp.mVertices[face[2] * 3 + 2];
-
-                        pMesh->mVertices[(pMesh->mMeshSize - 3) * 3 + 0] = temp.mVertices[face[0] * 3 + 0];
-                        pMesh->mVertices[(pMesh->mMeshSize - 3) * 3 + 1] = temp.mVertices[face[0] * 3 + 1];
-                        pMesh->mVertices[(pMesh->mMeshSize - 3) * 3 + 2] = temp.mVertices[face[0] * 3 + 2];
-
-                        pMesh->mVertices[(pMesh->mMeshSize - 2) * 3 + 0] = temp.mVertices[face[1] * 3 + 0];
-                        pMesh->mVertices[(pMesh->mMeshSize - 2) * 3 + 1] = temp.mVertices[face[1] * 3 + 1];
-                        pMesh->mVertices[(pMesh->mMeshSize - 2) * 3 + 2] = temp.mVertices[face[1] * 3 + 2];
-
-                        pMesh->mVertices[(pMesh->mMeshSize - 1) * 3 + 0] = temp.mVertices[face[3] * 3 + 0];
-                        pMesh->mVertices[(pMesh->mMeshSize - 1) * 3 + 1] = temp.mVertices[face[3] * 3 + 1];
-                        pMesh->mVertices[(pMesh->mMeshSize - 1) * 3 + 2] = temp.mVertices[face[3] * 3 + 2];
-
-                        pMesh->mNormals[(pMesh->mMeshSize - 6) * 3 + 0] = temp.mNormals[face[0] * 3 + 0];
-                        pMesh->mNormals[(pMesh->mMeshSize - 6) * 3 + 1] = temp.mNormals[face[0] * 3 + 1];
-                        pMesh->mNormals[(pMesh->mMeshSize - 6) * 3 + 2] = temp.mNormals[face[0] * 3 + 2];
-                    
-                        pMesh->mNormals[(pMesh->mMeshSize - 5) * 3 + 0] = temp.mNormals[face[1] * 3 + 0];
-                        pMesh->mNormals[(pMesh->mMeshSize - 5) * 3 + 1] = temp.mNormals[face[1] * 3 + 1];
-                        pMesh->mNormals[(pMesh->mMeshSize - 5) * 3 + 2] = temp.mNormals[face[1] * 3 + 2];
-
-                        pMesh->mNormals[(pMesh->mMeshSize - 4) * 3 + 0] = temp.mNormals[face[2] * 3 + 0];
-                        pMesh->mNormals[(pMesh->mMeshSize - 4) * 3 + 1] = temp.mNormals[face[2] * 3 + 1];
-                        pMesh->mNormals[(pMesh->mMeshSize - 4) * 3 + 2] = temp.mNormals[face[2] * 3 + 2];
-
-                        pMesh->mNormals[(pMesh->mMeshSize - 3) * 3 + 0] = temp.mNormals[face[0] * 3 + 0];
-                        pMesh->mNormals[(pMesh->mMeshSize - 3) * 3 + 1] = temp.mNormals[face[0] * 3 + 1];
-                        pMesh->mNormals[(pMesh->mMeshSize - 3) * 3 + 2] = temp.mNormals[face[0] * 3 + 2];
-
-                        pMesh->mNormals[(pMesh->mMeshSize - 2) * 3 + 0] = temp.mNormals[face[1] * 3 + 0];
-                        pMesh->mNormals[(pMesh->mMeshSize - 2) * 3 + 1] = temp.mNormals[face[1] * 3 + 1];
-                        pMesh->mNormals[(pMesh->mMeshSize - 2) * 3 + 2] = temp.mNormals[face[1] * 3 + 2];
-
-                        pMesh->mNormals[(pMesh->mMeshSize - 1) * 3 + 0] = temp.mNormals[face[3] * 3 + 0];
-                        pMesh->mNormals[(pMesh->mMeshSize - 1) * 3 + 1] = temp.mNormals[face[3] * 3 + 1];
-                        pMesh->mNormals[(pMesh->mMeshSize - 1) * 3 + 2] = temp.mNormals[face[3] * 3 + 2];
-
-                        pMesh->mTextureCoordinates[(pMesh->mMeshSize - 6) * 2 + 0] = temp.mTextureCoordinates[face[0] * 2 + 0];
-                        pMesh->mTextureCoordinates[(pMesh->mMeshSize - 6) * 2 + 1] = temp.mTextureCoordinates[face[0] * 2 + 1];
-                    
-                        pMesh->mTextureCoordinates[(pMesh->mMeshSize - 5) * 2 + 0] = temp.mTextureCoordinates[face[1] * 2 + 0];
-                        pMesh->mTextureCoordinates[(pMesh->mMeshSize - 5) * 2 + 1] = temp.mTextureCoordinates[face[1] * 2 + 1];
-
-                        pMesh->mTextureCoordinates[(pMesh->mMeshSize - 4) * 2 + 0] = temp.mTextureCoordinates[face[2] * 2 + 0];
-                        pMesh->mTextureCoordinates[(pMesh->mMeshSize - 4) * 2 + 1] = temp.mTextureCoordinates[face[2] * 2 + 1];
-
-                        pMesh->mTextureCoordinates[(pMesh->mMeshSize - 3) * 2 + 0] = temp.mTextureCoordinates[face[0] * 2 + 0];
-                        pMesh->mTextureCoordinates[(pMesh->mMeshSize - 3) * 2 + 1] = temp.mTextureCoordinates[face[0] * 2 + 1];
-
-                        pMesh->mTextureCoordinates[(pMesh->mMeshSize - 2) * 2 + 0] = temp.mTextureCoordinates[face[1] * 2 + 0];
-                        pMesh->mTextureCoordinates[(pMesh->mMeshSize - 2) * 2 + 1] = temp.mTextureCoordinates[face[1] * 2 + 1];
-
-                        pMesh->mTextureCoordinates[(pMesh->mMeshSize - 1) * 2 + 0] = temp.mTextureCoordinates[face[3] * 2 + 0];
-                        pMesh->mTextureCoordinates[(pMesh->mMeshSize - 1) * 2 + 1] = temp.mTextureCoordinates[face[3] * 2 + 1];
-                    }
-                    else {
-                        uint32_t face[3] = {};
+            }
 
-                        current_pos += CopyNumber(number, line + current_pos, 256, ' ');
-                        face[0] = atoi(number);
-                        current_pos += CopyNumber(number, line + current_pos, 256, ' ');
-                        face[1] = atoi(number);
-                        current_pos += CopyNumber(number, line + current_pos, 256, '\n');
-                        face[2] = atoi(number);
+            __MWriteComponents(&bytes[i * stride + attribute->mOffset], values, attribute);
+        }
+    }
+}
 
-                        MAllocMesh(pMesh, pMesh->mMeshSize + 3);
+void __MPLYCopyCorner(Mesh_t* pMesh, size_t dst, const Mesh_t* pSrc, uint32_t src) {
+    memcpy(&pMesh->mVertices[dst * 3], &pSrc->mVertices[src * 3], sizeof(float) * 3);
+    memcpy(&pMesh->mNormals[dst * 3], &pSrc->mNormals[src * 3], sizeof(float) * 3);
+    memcpy(&pMesh->mTextureCoordinates[dst * 2], &pSrc->mTextureCoordinates[src * 2], sizeof(float) * 2);
+    memcpy(&pMesh->mColors[dst * 4], &pSrc->mColors[src * 4], sizeof(float) * 4);
+}
 
-                        pMesh->mVertices[(pMesh->mMeshSize - 3) * 3 + 0] = temp.mVertices[face[0] * 3 + 0];
-                        pMesh->mVertices[(pMesh->mMeshSize - 3) * 3 + 1] = temp.mVertices[face[0] * 3 + 1];
-                        pMesh->mVertices[(pMesh->mMeshSize - 3) * 3 + 2] = temp.mVertices[face[0] * 3 + 2];
+uint32_t __MPLYFaceCorners(uint32_t faceSize) {
+    return faceSize < 3 || faceSize > PLY_MAX_FACE_INDICES ? 0 : (faceSize - 2) * 3;
+}
 
-                        pMesh->mVertices[(pMesh->mMeshSize - 2) * 3 + 0] = temp.mVertices[face[1] * 3 + 0];
-                        pMesh->mVertices[(pMesh->mMeshSize - 2) * 3 + 1] = temp.mVertices[face[1] * 3 + 1];
-                        pMesh->mVertices[(pMesh->mMeshSize - 2) * 3 + 2] = temp.mVertices[face[1] * 3 + 2];
+bool __MPLYFaceValid(const Mesh_t* pSrc, const uint32_t* face, uint32_t faceSize) {
+    // face readers fill at most PLY_MAX_FACE_INDICES indices, bigger face is skipped without reading them
+    if(faceSize < 3 || faceSize > PLY_MAX_FACE_INDICES) {
+        return false;
+    }
 
-                        pMesh->mVertices[(pMesh->mMeshSize - 1) * 3 + 0] = temp.mVertices[face[2] * 3 + 0];
-                        pMesh->mVertices[(pMesh->mMeshSize - 1) * 3 + 1] = temp.mVertices[face[2] * 3 + 1];
-                        pMesh->mVertices[(pMesh->mMeshSize - 1) * 3 + 2] = temp.mVertices[face[2] * 3 + 2];
+    for(uint32_t i = 0; i < faceSize; i++) {
+        if(face[i] >= pSrc->mMeshSize) {
+            return false;
+        }
+    }
 
-                        pMesh->mNormals[(pMesh->mMeshSize - 3) * 3 + 0] = temp.mNormals[face[0] * 3 + 0];
-                        pMesh->mNormals[(pMesh->mMeshSize - 3) * 3 + 1] = temp.mNormals[face[0] * 3 + 1];
-                        pMesh->mNormals[(pMesh->mMeshSize - 3) * 3 + 2] = temp.mNormals[face[0] * 3 + 2];
+    return true;
+}
 
-                        pMesh->mNormals[(pMesh->mMeshSize - 2) * 3 + 0] = temp.mNormals[face[1] * 3 + 0];
-                        pMesh->mNormals[(pMesh->mMeshSize - 2) * 3 + 1] = temp.mNormals[face[1] * 3 + 1];
-                        pMesh->mNormals[(pMesh->mMeshSize - 2) * 3 + 2] = temp.mNormals[face[1] * 3 + 2];
+/**
+ * @brief Checks if 2D point lies inside or on edge of triangle with given winding
+ * 
+ * @return true when point is inside
+ */
+bool __MPLYPointInTriangle(const float* px, const float* py, uint32_t a, uint32_t b, uint32_t c, uint32_t p, float winding) {
+    float ab = ((px[b] - px[a]) * (py[p] - py[a]) - (py[b] - py[a]) * (px[p] - px[a])) * winding;
+    float bc = ((px[c] - px[b]) * (py[p] - py[b]) - (py[c] - py[b]) * (px[p] - px[b])) * winding;
+    float ca = ((px[a] - px[c]) * (py[p] - py[c]) - (py[a] - py[c]) * (px[p] - px[c])) * winding;
+
+    return ab >= 0.0f && bc >= 0.0f && ca >= 0.0f;
+}
 
-                        pMesh->mNormals[(pMesh->mMeshSize - 1) * 3 + 0] = temp.mNormals[face[2] * 3 + 0];
-                        pMesh->mNormals[(pMesh->mMeshSize - 1) * 3 + 1] = temp.mNormals[face[2] * 3 + 1];
-                        pMesh->mNormals[(pMesh->mMeshSize - 1) * 3 + 2] = temp.mNormals[face[2] * 3 + 2];
+/**
+ * @brief Splits polygon into triangles of face corners. Convex polygons are fanned from first corner, concave polygons are ear clipped in plane of their Newell normal. Works on stack only
+ * 
+ * @param pSrc vertex table (positions are used to detect concave polygons)
+ * @param face face indices
+ * @param faceSize face indices amount, 3 to PLY_MAX_FACE_INDICES
+ * @param triangles output face corners, (faceSize - 2) * 3 of them
+ */
+void __MPLYTriangulate(const Mesh_t* pSrc, const uint32_t* face, uint32_t faceSize, uint32_t* triangles) {
+    uint32_t written = 0;
+
+    if(faceSize > 3) {
+        float normal[3] = {0.0f, 0.0f, 0.0f};
+
+        for(uint32_t i = 0; i < faceSize; i++) {
+            const float* a = &pSrc->mVertices[face[i] * 3];
+            const float* b = &pSrc->mVertices[face[(i + 1) % faceSize] * 3];
+
+            normal[0] += (a[1] - b[1]) * (a[2] + b[2]);
+            normal[1] += (a[2] - b[2]) * (a[0] + b[0]);
+            normal[2] += (a[0] - b[0]) * (a[1] + b[1]);
+        }
 
-                        pMesh->mTextureCoordinates[(pMesh->mMeshSize - 3) * 2 + 0] = temp.mTextureCoordinates[face[0] * 2 + 0];
-                        pMesh->mTextureCoordinates[(pMesh->mMeshSize - 3) * 2 + 1] = temp.mTextureCoordinates[face[0] * 2 + 1];
+        uint32_t axis = fabsf(normal[0]) > fabsf(normal[1]) ? (fabsf(normal[0]) > fabsf(normal[2]) ? 0 : 2) : (fabsf(normal[1]) > fabsf(normal[2]) ? 1 : 2);
+        uint32_t u_axis = (axis + 1) % 3, v_axis = (axis + 2) % 3;
+        float winding = normal[axis] < 0.0f ? -1.0f : 1.0f;
 
-                        pMesh->mTextureCoordinates[(pMesh->mMeshSize - 2) * 2 + 0] = temp.mTextureCoordinates[face[1] * 2 + 0];
-                        pMesh->mTextureCoordinates[(pMesh->mMeshSize - 2) * 2 + 1] = temp.mTextureCoordinates[face[1] * 2 + 1];
+        float px[PLY_MAX_FACE_INDICES], py[PLY_MAX_FACE_INDICES];
+        uint32_t next[PLY_MAX_FACE_INDICES], prev[PLY_MAX_FACE_INDICES];
+        bool convex = true;
 
-                        pMesh->mTextureCoordinates[(pMesh->mMeshSize - 1) * 2 + 0] = temp.mTextureCoordinates[face[2] * 2 + 0];
-                        pMesh->mTextureCoordinates[(pMesh->mMeshSize - 1) * 2 + 1] = temp.mTextureCoordinates[face[2] * 2 + 1];
-                    }
+        for(uint32_t i = 0; i < faceSize; i++) {
+            px[i] = pSrc->mVertices[face[i] * 3 + u_axis];
+            py[i] = pSrc->mVertices[face[i] * 3 + v_axis];
+            next[i] = (i + 1) % faceSize;
+            prev[i] = (i + faceSize - 1) % faceSize;
+        }
 
-                    face_counter++;
+        for(uint32_t i = 0; i < faceSize && convex; i++) {
+            uint32_t a = prev[i], b = next[i];
 
-                    continue;
-                }
+            convex = ((px[i] - px[a]) * (py[b] - py[i]) - (py[i] - py[a]) * (px[b] - px[i])) * winding >= 0.0f;
+        }
+
+        uint32_t remaining = faceSize, ear = 0, tries = 0;
+
+        while(!convex && remaining > 3 && tries < remaining) {
+            uint32_t a = prev[ear], b = next[ear];
+            bool is_ear = ((px[ear] - px[a]) * (py[b] - py[ear]) - (py[ear] - py[a]) * (px[b] - px[ear])) * winding > 0.0f;
+
+            for(uint32_t p = next[b]; p != a && is_ear; p = next[p]) {
+                is_ear = !__MPLYPointInTriangle(px, py, a, ear, b, p, winding);
             }
-            else {
-                if(vertex_counter < vertex_amount) {                   
-                    if(prop_vertices != SIZE_MAX) {
-                        temp.mVertices[mv_counter++] = CBytesToFloat(/*CBytesToLittleEndian*/(((uint32_t)ch << 24) | ((uint32_t)fgetc(mesh_file) << 16) | ((uint32_t)fgetc(mesh_file) << 8) | (uint32_t)fgetc(mesh_file)));
-                        temp.mVertices[mv_counter++] = CBytesToFloat(/*CBytesToLittleEndian*/(((uint32_t)fgetc(mesh_file) << 24) | ((uint32_t)fgetc(mesh_file) << 16) | ((uint32_t)fgetc(mesh_file) << 8) | (uint32_t)fgetc(mesh_file)));
-                        temp.mVertices[mv_counter++] = CBytesToFloat(/*CBytesToLittleEndian*/(((uint32_t)fgetc(mesh_file) << 24) | ((uint32_t)fgetc(mesh_file) << 16) | ((uint32_t)fgetc(mesh_file) << 8) | (uint32_t)fgetc(mesh_file)));
-                    }
 
-                    if(prop_normals != SIZE_MAX) {
-                        temp.mNormals[mn_counter++] = CBytesToFloat(/*CBytesToLittleEndian*/((uint32_t)fgetc(mesh_file) << 24 | (uint32_t)fgetc(mesh_file) << 16 | (uint32_t)fgetc(mesh_file) << 8 | (uint32_t)fgetc(mesh_file)));
-                        temp.mNormals[mn_counter++] = CBytesToFloat(/*CBytesToLittleEndian*/((uint32_t)fgetc(mesh_file) << 24 | (uint32_t)fgetc(mesh_file) << 16 | (uint32_t)fgetc(mesh_file) << 8 | (uint32_t)fgetc(mesh_file)));
-                        temp.mNormals[mn_counter++] = CBytesToFloat(/*CBytesToLittleEndian*/((uint32_t)fgetc(mesh_file) << 24 | (uint32_t)fgetc(mesh_file) << 16 | (uint32_t)fgetc(mesh_file) << 8 | (uint32_t)fgetc(mesh_file)));
-                    }
+            if(!is_ear) {
+                ear = next[ear];
+                tries++;
 
-                    if(prop_texturepos != SIZE_MAX) {
-                        temp.mTextureCoordinates[mt_counter++] = CBytesToFloat(/*CBytesToLittleEndian*/((uint32_t)fgetc(mesh_file) << 24 | (uint32_t)fgetc(mesh_file) << 16 | (uint32_t)fgetc(mesh_file) << 8 | (uint32_t)fgetc(mesh_file)));
-                        temp.mTextureCoordinates[mt_counter++] = CBytesToFloat(/*CBytesToLittleEndian*/((uint32_t)fgetc(mesh_file) << 24 | (uint32_t)fgetc(mesh_file) << 16 | (uint32_t)fgetc(mesh_file) << 8 | (uint32_t)fgetc(mesh_file)));
-                    }
+                continue;
+            }
 
-                    vertex_counter++;
+            triangles[written++] = a;
+            triangles[written++] = ear;
+            triangles[written++] = b;
 
-                    continue;
-                }
-                
-                if(face_counter < face_amount) {
-                    char faces_value_amount = (char)ch;
-
-                    if(faces_value_amount == 4) {
-                        uint32_t face[4] = {};
-
-                        face[0] = CBytesToLittleEndian((uint32_t)fgetc(mesh_file) << 24 | (uint32_t)fgetc(mesh_file) << 16 | (uint32_t)fgetc(mesh_file) << 8 | (uint32_t)fgetc(mesh_file));
-                        face[1] = CBytesToLittleEndian((uint32_t)fgetc(mesh_file) << 24 | (uint32_t)fgetc(mesh_file) << 16 | (uint32_t)fgetc(mesh_file) << 8 | (uint32_t)fgetc(mesh_file));
-                        face[2] = CBytesToLittleEndian((uint32_t)fgetc(mesh_file) << 24 | (uint32_t)fgetc(mesh_file) << 16 | (uint32_t)fgetc(mesh_file) << 8 | (uint32_t)fgetc(mesh_file));
-                        face[3] = CBytesToLittleEndian((uint32_t)fgetc(mesh_file) << 24 | (uint32_t)fgetc(mesh_file) << 16 | (uint32_t)fgetc(mesh_file) << 8 | (uint32_t)fgetc(mesh_file));
-
-                        MAllocMesh(pMesh, pMesh->mMeshSize + 6);
-
-                        pMesh->mVertices[(pMesh->mMeshSize - 6) * 3 + 0] = temp.mVertices[face[0] * 3 + 0];
-                        pMesh->mVertices[(pMesh->mMeshSize - 6) * 3 + 1] = temp.mVertices[face[0] * 3 + 1];
-                        pMesh->mVertices[(pMesh->mMeshSize - 6) * 3 + 2] = temp.mVertices[face[0] * 3 + 2];
-                    
-                        pMesh->mVertices[(pMesh->mMeshSize - 5) * 3 + 0] = temp.mVertices[face[1] * 3 + 0];
-                        pMesh->mVertices[(pMesh->mMeshSize - 5) * 3 + 1] = temp.mVertices[face[1] * 3 + 1];
-                        pMesh->mVertices[(pMesh->mMeshSize - 5) * 3 + 2] = temp.mVertices[face[1] * 3 + 2];
-
-                        pMesh->mVertices[(pMesh->mMeshSize - 4) * 3 + 0] = temp.mVertices[face[2] * 3 + 0];
-                        pMesh->mVertices[(pMesh->mMeshSize - 4) * 3 + 1] = temp.mVertices[face[2] * 3 + 1];
-                        pMesh->mVertices[(pMesh->mMeshSize - 4) * 3 + 2] = temp.mVertices[face[2] * 3 + 2];
-
-                        pMesh->mVertices[(pMesh->mMeshSize - 3) * 3 + 0] = temp.mVertices[face[0] * 3 + 0];
-                        pMesh->mVertices[(pMesh->mMeshSize - 3) * 3 + 1] = temp.mVertices[face[0] * 3 + 1];
-                        pMesh->mVertices[(pMesh->mMeshSize - 3) * 3 + 2] = temp.mVertices[face[0] * 3 + 2];
-
-                        pMesh->mVertices[(pMesh->mMeshSize - 2) * 3 + 0] = temp.mVertices[face[1] * 3 + 0];
-                        pMesh->mVertices[(pMesh->mMeshSize - 2) * 3 + 1] = temp.mVertices[face[1] * 3 + 1];
-                        pMesh->mVertices[(pMesh->mMeshSize - 2) * 3 + 2] = temp.mVertices[face[1] * 3 + 2];
-
-                        pMesh->mVertices[(pMesh->mMeshSize - 1) * 3 + 0] = temp.mVertices[face[3] * 3 + 0];
-                        pMesh->mVertices[(pMesh->mMeshSize - 1) * 3 + 1] = temp.mVertices[face[3] * 3 + 1];
-                        pMesh->mVertices[(pMesh->mMeshSize - 1) * 3 + 2] = temp.mVertices[face[3] * 3 + 2];
-
-                        pMesh->mNormals[(pMesh->mMeshSize - 6) * 3 + 0] = temp.mNormals[face[0] * 3 + 0];
-                        pMesh->mNormals[(pMesh->mMeshSize - 6) * 3 + 1] = temp.mNormals[face[0] * 3 + 1];
-                        pMesh->mNormals[(pMesh->mMeshSize - 6) * 3 + 2] = temp.mNormals[face[0] * 3 + 2];
-                    
-                        pMesh->mNormals[(pMesh->mMeshSize - 5) * 3 + 0] = temp.mNormals[face[1] * 3 + 0];
-                        pMesh->mNormals[(pMesh->mMeshSize - 5) * 3 + 1] = temp.mNormals[face[1] * 3 + 1];
-                        pMesh->mNormals[(pMesh->mMeshSize - 5) * 3 + 2] = temp.mNormals[face[1] * 3 + 2];
-
-                        pMesh->mNormals[(pMesh->mMeshSize - 4) * 3 + 0] = temp.mNormals[face[2] * 3 + 0];
-                        pMesh->mNormals[(pMesh->mMeshSize - 4) * 3 + 1] = temp.mNormals[face[2] * 3 + 1];
-                        pMesh->mNormals[(pMesh->mMeshSize - 4) * 3 + 2] = temp.mNormals[face[2] * 3 + 2];
-
-                        pMesh->mNormals[(pMesh->mMeshSize - 3) * 3 + 0] = temp.mNormals[face[0] * 3 + 0];
-                        pMesh->mNormals[(pMesh->mMeshSize - 3) * 3 + 1] = temp.mNormals[face[0] * 3 + 1];
-                        pMesh->mNormals[(pMesh->mMeshSize - 3) * 3 + 2] = temp.mNormals[face[0] * 3 + 2];
-
-                        pMesh->mNormals[(pMesh->mMeshSize - 2) * 3 + 0] = temp.mNormals[face[1] * 3 + 0];
-                        pMesh->mNormals[(pMesh->mMeshSize - 2) * 3 + 1] = temp.mNormals[face[1] * 3 + 1];
-                        pMesh->mNormals[(pMesh->mMeshSize - 2) * 3 + 2] = temp.mNormals[face[1] * 3 + 2];
-
-                        pMesh->mNormals[(pMesh->mMeshSize - 1) * 3 + 0] = temp.mNormals[face[3] * 3 + 0];
-                        pMesh->mNormals[(pMesh->mMeshSize - 1) * 3 + 1] = temp.mNormals[face[3] * 3 + 1];
-                        pMesh->mNormals[(pMesh->mMeshSize - 1) * 3 + 2] = temp.mNormals[face[3] * 3 + 2];
-
-                        pMesh->mTextureCoordinates[(pMesh->mMeshSize - 6) * 2 + 0] = temp.mTextureCoordinates[face[0] * 2 + 0];
-                        pMesh->mTextureCoordinates[(pMesh->mMeshSize - 6) * 2 + 1] = temp.mTextureCoordinates[face[0] * 2 + 1];
-                    
-                        pMesh->mTextureCoordinates[(pMesh->mMeshSize - 5) * 2 + 0] = temp.mTextureCoordinates[face[1] * 2 + 0];
-                        pMesh->mTextureCoordinates[(pMesh->mMeshSize - 5) * 2 + 1] = temp.mTextureCoordinates[face[1] * 2 + 1];
-
-                        pMesh->mTextureCoordinates[(pMesh->mMeshSize - 4) * 2 + 0] = temp.mTextureCoordinates[face[2] * 2 + 0];
-                        pMesh->mTextureCoordinates[(pMesh->mMeshSize - 4) * 2 + 1] = temp.mTextureCoordinates[face[2] * 2 + 1];
-
-                        pMesh->mTextureCoordinates[(pMesh->mMeshSize - 3) * 2 + 0] = temp.mTextureCoordinates[face[0] * 2 + 0];
-                        pMesh->mTextureCoordinates[(pMesh->mMeshSize - 3) * 2 + 1] = temp.mTextureCoordinates[face[0] * 2 + 1];
-
-                        pMesh->mTextureCoordinates[(pMesh->mMeshSize - 2) * 2 + 0] = temp.mTextureCoordinates[face[1] * 2 + 0];
-                        pMesh->mTextureCoordinates[(pMesh->mMeshSize - 2) * 2 + 1] = temp.mTextureCoordinates[face[1] * 2 + 1];
-
-                        pMesh->mTextureCoordinates[(pMesh->mMeshSize - 1) * 2 + 0] = temp.mTextureCoordinates[face[3] * 2 + 0];
-                        pMesh->mTextureCoordinates[(pMesh->mMeshSize - 1) * 2 + 1] = temp.mTextureCoordinates[face[3] * 2 + 1];
-                    }
-                    else {
-                        uint32_t face[3] = {};
+            next[a] = b;
+            prev[b] = a;
+            ear = b;
+            tries = 0;
+            remaining--;
+        }
 
-                        face[0] = CBytesToLittleEndian((uint32_t)fgetc(mesh_file) << 24 | (uint32_t)fgetc(mesh_file) << 16 | (uint32_t)fgetc(mesh_file) << 8 | (uint32_t)fgetc(mesh_file));
-                        face[1] = CBytesToLittleEndian((uint32_t)fgetc(mesh_file) << 24 | (uint32_t)fgetc(mesh_file) << 16 | (uint32_t)fgetc(mesh_file) << 8 | (uint32_t)fgetc(mesh_file));
-                        face[2] = CBytesToLittleEndian((uint32_t)fgetc(mesh_file) << 24 | (uint32_t)fgetc(mesh_file) << 16 | (uint32_t)fgetc(mesh_file) << 8 | (uint32_t)fgetc(mesh_file));
+        if(!convex) {
+            // rest (last triangle or degenerate polygon without ears) is fanned
+            for(uint32_t i = next[ear]; next[i] != ear; i = next[i]) {
+                triangles[written++] = ear;
+                triangles[written++] = i;
+                triangles[written++] = next[i];
+            }
 
-                        MAllocMesh(pMesh, pMesh->mMeshSize + 3);
+            return;
+        }
+    }
 
-                        pMesh->mVertices[(pMesh->mMeshSize - 3) * 3 + 0] = temp.mVertices[face[0] * 3 + 0];
-                        pMesh->mVertices[(pMesh->mMeshSize - 3) * 3 + 1] = temp.mVertices[face[0] * 3 + 1];
-                        pMesh->mVertices[(pMesh->mMeshSize - 3) * 3 + 2] = temp.mVertices[face[0] * 3 + 2];
+    for(uint32_t i = 1; i + 1 < faceSize; i++) {
+        triangles[written++] = 0;
+        triangles[written++] = i;
+        triangles[written++] = i + 1;
+    }
+}
 
-                        pMesh->mVertices[(pMesh->mMeshSize - 2) * 3 + 0] = temp.mVertices[face[1] * 3 + 0];
-                        pMesh->mVertices[(pMesh->mMeshSize - 2) * 3 + 1] = temp.mVertices[face[1] * 3 + 1];
-                        pMesh->mVertices[(pMesh->mMeshSize - 2) * 3 + 2] = temp.mVertices[face[1] * 3 + 2];
+/**
+ * @brief Writes face triangles at dst, mesh has to be already big enough. Indexed output writes indices rebased onto current mesh size (vertex table is appended after faces)
+ * 
+ * @param pMesh output mesh
+ * @param dst first output vertex or index
+ * @param pSrc vertex table
+ * @param face face indices
+ * @param faceSize face indices amount
+ * @param indexed write indices instead of vertices
+ * @return uint32_t amount of written vertices or indices
+ */
+uint32_t __MPLYWriteFace(Mesh_t* pMesh, size_t dst, const Mesh_t* pSrc, const uint32_t* face, uint32_t faceSize, bool indexed) {
+    uint32_t order[(PLY_MAX_FACE_INDICES - 2) * 3];
+    uint32_t corners = __MPLYFaceCorners(faceSize);
+
+    __MPLYTriangulate(pSrc, face, faceSize, order);
+
+    for(uint32_t i = 0; i < corners; i++) {
+        if(indexed) {
+            pMesh->mIndices[dst + i] = (uint32_t)pMesh->mMeshSize + face[order[i]];
+        }
+        else {
+            __MPLYCopyCorner(pMesh, dst + i, pSrc, face[order[i]]);
+        }
+    }
 
-                        pMesh->mVertices[(pMesh->mMeshSize - 1) * 3 + 0] = temp.mVertices[face[2] * 3 + 0];
-                        pMesh->mVertices[(pMesh->mMeshSize - 1) * 3 + 1] = temp.mVertices[face[2] * 3 + 1];
-                        pMesh->mVertices[(pMesh->mMeshSize - 1) * 3 + 2] = temp.mVertices[face[2] * 3 + 2];
+    return corners;
+}
 
-                        pMesh->mNormals[(pMesh->mMeshSize - 3) * 3 + 0] = temp.mNormals[face[0] * 3 + 0];
-                        pMesh->mNormals[(pMesh->mMeshSize - 3) * 3 + 1] = temp.mNormals[face[0] * 3 + 1];
-                        pMesh->mNormals[(pMesh->mMeshSize - 3) * 3 + 2] = temp.mNormals[face[0] * 3 + 2];
+void __MPLYEmitFace(Mesh_t* pMesh, const Mesh_t* pSrc, const uint32_t* face, uint32_t faceSize, bool indexed) {
+    if(!__MPLYFaceValid(pSrc, face, faceSize)) {
+        E_WARN_ARG("Face index is out of %zu vertices or face has more than %d indices, skipping face!", pSrc->mMeshSize, PLY_MAX_FACE_INDICES);
 
-                        pMesh->mNormals[(pMesh->mMeshSize - 2) * 3 + 0] = temp.mNormals[face[1] * 3 + 0];
-                        pMesh->mNormals[(pMesh->mMeshSize - 2) * 3 + 1] = temp.mNormals[face[1] * 3 + 1];
-                        pMesh->mNormals[(pMesh->mMeshSize - 2) * 3 + 2] = temp.mNormals[face[1] * 3 + 2];
+        return;
+    }
 
-                        pMesh->mNormals[(pMesh->mMeshSize - 1) * 3 + 0] = temp.mNormals[face[2] * 3 + 0];
-                        pMesh->mNormals[(pMesh->mMeshSize - 1) * 3 + 1] = temp.mNormals[face[2] * 3 + 1];
-                        pMesh->mNormals[(pMesh->mMeshSize - 1) * 3 + 2] = temp.mNormals[face[2] * 3 + 2];
+    size_t dst = indexed ? pMesh->mIndexCount : pMesh->mMeshSize;
 
-                        pMesh->mTextureCoordinates[(pMesh->mMeshSize - 3) * 2 + 0] = temp.mTextureCoordinates[face[0] * 2 + 0];
-                        pMesh->mTextureCoordinates[(pMesh->mMeshSize - 3) * 2 + 1] = temp.mTextureCoordinates[face[0] * 2 + 1];
+    if(indexed) {
+        MAllocIndices(pMesh, dst + __MPLYFaceCorners(faceSize));
+    }
+    else {
+        MAllocMesh(pMesh, dst + __MPLYFaceCorners(faceSize));
+    }
 
-                        pMesh->mTextureCoordinates[(pMesh->mMeshSize - 2) * 2 + 0] = temp.mTextureCoordinates[face[1] * 2 + 0];
-                        pMesh->mTextureCoordinates[(pMesh->mMeshSize - 2) * 2 + 1] = temp.mTextureCoordinates[face[1] * 2 + 1];
+    __MPLYWriteFace(pMesh, dst, pSrc, face, faceSize, indexed);
+}
 
-                        pMesh->mTextureCoordinates[(pMesh->mMeshSize - 1) * 2 + 0] = temp.mTextureCoordinates[face[2] * 2 + 0];
-                        pMesh->mTextureCoordinates[(pMesh->mMeshSize - 1) * 2 + 1] = temp.mTextureCoordinates[face[2] * 2 + 1];
-                    }
+/**
+ * @brief Decode table entry of one .ply vertex property, built once per schema by __MPLYMapVertexProperties
+ */
+typedef struct PLYVertexField_s {
+    float* mStream;
+    uint32_t mStride;
+    uint32_t mOffset;
+    float mScale;
+    PFN_PLYReadValue mRead;
+} PLYVertexField_t;
+
+/**
+ * @brief Builds decode table of .ply vertex element, properties are mapped onto temporary mesh streams by name and unknown properties are skipped
+ * 
+ * @param pElement vertex element
+ * @param pTemp temporary mesh with vertex element count size
+ * @param fields per property decode table entry, mStream is nullptr for skipped property
+ * @param swap true when binary records endianess differs from host
+ */
+void __MPLYMapVertexProperties(const PLYElement_t* pElement, Mesh_t* pTemp, PLYVertexField_t* fields, bool swap) {
+    const char* names[] = { "x", "y", "z", "nx", "ny", "nz", "s", "t", "u", "v", "texture_u", "texture_v", "red", "green", "blue", "alpha", "diffuse_red", "diffuse_green", "diffuse_blue" };
+    float* streams[] = { pTemp->mVertices, pTemp->mVertices + 1, pTemp->mVertices + 2, pTemp->mNormals, pTemp->mNormals + 1, pTemp->mNormals + 2, pTemp->mTextureCoordinates, pTemp->mTextureCoordinates + 1, pTemp->mTextureCoordinates, pTemp->mTextureCoordinates + 1, pTemp->mTextureCoordinates, pTemp->mTextureCoordinates + 1, pTemp->mColors, pTemp->mColors + 1, pTemp->mColors + 2, pTemp->mColors + 3, pTemp->mColors, pTemp->mColors + 1, pTemp->mColors + 2 };
+    const uint32_t stream_strides[] = { 3, 3, 3, 3, 3, 3, 2, 2, 2, 2, 2, 2, 4, 4, 4, 4, 4, 4, 4 };
+    const uint32_t first_color = 12;
+
+    for(uint32_t i = 0; i < pElement->mPropertyCount; i++) {
+        const PLYProperty_t* property = &pElement->mProperties[i];
+
+        memset(&fields[i], 0, sizeof(PLYVertexField_t));
+
+        if(property->mList) {
+            continue;
+        }
 
-                    face_counter++;
+        for(uint32_t j = 0; j < sizeof(names) / sizeof(names[0]); j++) {
+            if(strcmp(property->mName, names[j]) == 0) {
+                fields[i].mStream = streams[j];
+                fields[i].mStride = stream_strides[j];
+                fields[i].mOffset = property->mOffset;
+                // integer colors are normalized, other integer properties keep their values
+                fields[i].mScale = j >= first_color ? 1.0f / PLYTypeMaximum(property->mType) : 1.0f;
+                fields[i].mRead = PLYGetValueReader(property->mType, swap);
 
-                    continue;
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Clears mesh streams that .ply vertex element does not fill completely (e.g. model without normals), missing colors are white
+ * 
+ * @param pElement vertex element
+ * @param pTemp mesh mapped by __MPLYMapVertexProperties
+ * @param fields vertex decode table
+ * @param count amount of vertices to clear
+ */
+void __MPLYClearUnmappedStreams(const PLYElement_t* pElement, Mesh_t* pTemp, const PLYVertexField_t* fields, size_t count) {
+    float* streams[] = { pTemp->mVertices, pTemp->mNormals, pTemp->mTextureCoordinates, pTemp->mColors };
+    const uint32_t components[] = { 3, 3, 2, 4 };
+
+    for(uint32_t i = 0; i < 4; i++) {
+        uint32_t mapped = 0;
+
+        for(uint32_t c = 0; c < components[i]; c++) {
+            for(uint32_t p = 0; p < pElement->mPropertyCount; p++) {
+                if(fields[p].mStream == streams[i] + c) {
+                    mapped++;
+
+                    break;
                 }
             }
         }
+
+        if(mapped == components[i]) {
+            continue;
+        }
+
+        if(streams[i] == pTemp->mColors) {
+            for(size_t v = 0; v < count * 4; v++) {
+                streams[i][v] = 1.0f;
+            }
+        }
+        else {
+            memset(streams[i], 0, sizeof(float) * components[i] * count);
+        }
     }
+}
+
+int32_t __MPLYFindFaceIndices(const PLYElement_t* pElement) {
+    int32_t result = PLYFindProperty(pElement, "vertex_indices");
 
-    MFreeMesh(&temp);
-    MECFree(line);
-    MECFree(source_buffer);
-    fclose(mesh_file);
+    if(result < 0) {
+        result = PLYFindProperty(pElement, "vertex_index");
+    }
 
-    for(size_t i = 0; i < pMesh->mMeshSize; i++) {
-        pMesh->mColors[i * 4 + 0] = 1.0f;
-        pMesh->mColors[i * 4 + 1] = 1.0f;
-        pMesh->mColors[i * 4 + 2] = 1.0f;
-        pMesh->mColors[i * 4 + 3] = 1.0f;
+    if(result >= 0 && !pElement->mProperties[result].mList) {
+        return -1;
     }
 
-    return;
+    return result;
 }
 
-typedef struct MeshData_s {
-    Mesh_t* mMeshes;
-    Transform_t* mMeshTransform;
-    Mesh_t mJoinedMesh;
-    Transform_t mTransform;
-    float* mTextureID;
-    uint32_t* mMeshStart;
+/**
+ * @brief Skips one binary .ply record of element with list properties
+ * 
+ * @param pElement element pointer
+ * @param cursor record start
+ * @param end source end
+ * @param bigEndian source endianess
+ * @return const uint8_t* next record or nullptr when record overflows source
+ */
+const uint8_t* __MPLYSkipBinaryRecord(const PLYElement_t* pElement, const uint8_t* cursor, const uint8_t* end, bool bigEndian) {
+    for(uint32_t i = 0; i < pElement->mPropertyCount; i++) {
+        const PLYProperty_t* property = &pElement->mProperties[i];
+        size_t skip = PLYTypeSize(property->mType);
+
+        if(property->mList) {
+            if((size_t)(end - cursor) < PLYTypeSize(property->mCountType)) return nullptr;
+
+            skip *= PLYReadIndex(cursor, property->mCountType, bigEndian);
+            cursor += PLYTypeSize(property->mCountType);
+        }
 
-    uint32_t mMeshCount;
-} MeshData_t;
+        if((size_t)(end - cursor) < skip) return nullptr;
 
-void __MDCalculateMeshEnds(MeshData_t* pData) {
-    pData->mMeshStart = MECRealloc(pData->mMeshStart, sizeof(uint32_t) * pData->mMeshCount);
+        cursor += skip;
+    }
 
-    for(uint32_t i = 0; i < pData->mMeshCount; i++) {
-        pData->mMeshStart[i] = (i == 0 ? 0 : pData->mMeshStart[i - 1]) + (i == 0 ? 0 : pData->mMeshes[i - 1].mMeshSize);
+    return cursor;
+}
+
+bool __MPLYSkipASCIIProperty(const PLYProperty_t* pProperty, const char** pLine, const char* lineEnd) {
+    uint32_t count = 1;
+    float value = 0.0f;
+
+    if(pProperty->mList && !CParseUInt(pLine, lineEnd, &count)) {
+        return false;
+    }
+
+    for(uint32_t i = 0; i < count; i++) {
+        if(!CParseFloat(pLine, lineEnd, &value)) {
+            return false;
+        }
     }
+
+    return true;
 }
 
-void MDRejoin(MeshData_t *pData) {
-    MECFree(pData->mMeshStart);
-    MFreeMesh(&pData->mJoinedMesh);
-    __MDCalculateMeshEnds(pData);
+/**
+ * @brief Parses ASCII vertex line into mapped streams
+ * 
+ * @param pElement vertex element
+ * @param fields vertex decode table
+ * @param record vertex index
+ * @param line line start
+ * @param lineEnd line end
+ * @return false when line is malformed
+ */
+bool __MPLYParseASCIIVertex(const PLYElement_t* pElement, const PLYVertexField_t* fields, size_t record, const char* line, const char* lineEnd) {
+    bool valid = true;
+
+    for(uint32_t p = 0; p < pElement->mPropertyCount; p++) {
+        float value = 0.0f;
+
+        if(pElement->mProperties[p].mList) {
+            valid &= __MPLYSkipASCIIProperty(&pElement->mProperties[p], &line, lineEnd);
+
+            continue;
+        }
 
-    for(uint32_t i = 0; i < pData->mMeshCount; i++) {
-        MAllocMesh(&pData->mJoinedMesh, pData->mJoinedMesh.mMeshSize + pData->mMeshes[i].mMeshSize);
+        valid &= CParseFloat(&line, lineEnd, &value);
+
+        if(fields[p].mStream != nullptr) {
+            fields[p].mStream[record * fields[p].mStride] = value * fields[p].mScale;
+        }
+    }
 
-        for(uint32_t j = 0; j < pData->mMeshes[i].mMeshSize; j++) {
-            vec4_t mat_pos = MX4MulV(pData->mMeshTransform[i].mTransformMat, (vec4_t){pData->mMeshes[i].mVertices[j * 3 + 0], pData->mMeshes[i].mVertices[j * 3 + 1], pData->mMeshes[i].mVertices[j * 3 + 2], 1.0});
+    return valid;
+}
+
+/**
+ * @brief Parses ASCII face line
+ * 
+ * @param pElement face element
+ * @param faceIndices vertex index list property
+ * @param line line start
+ * @param lineEnd line end
+ * @param face output indices (PLY_MAX_FACE_INDICES max, longer faces are not read)
+ * @param pFaceSize output declared face indices amount
+ * @return false when line is malformed
+ */
+bool __MPLYParseASCIIFace(const PLYElement_t* pElement, int32_t faceIndices, const char* line, const char* lineEnd, uint32_t* face, uint32_t* pFaceSize) {
+    bool valid = true;
+
+    for(int32_t p = 0; p < faceIndices; p++) {
+        valid &= __MPLYSkipASCIIProperty(&pElement->mProperties[p], &line, lineEnd);
+    }
+
+    *pFaceSize = 0;
 
-            pData->mJoinedMesh.mVertices[(pData->mJoinedMesh.mMeshSize - pData->mMeshes[i].mMeshSize) + j * 3 + 0] = mat_pos.x;
-            pData->mJoinedMesh.mVertices[(pData->mJoinedMesh.mMeshSize - pData->mMeshes[i].mMeshSize) + j * 3 + 1] = mat_pos.y;
-            pData->mJoinedMesh.mVertices[(pData->mJoinedMesh.mMeshSize - pData->mMeshes[i].mMeshSize) + j * 3 + 2] = mat_pos.z;
+    if(!CParseUInt(&line, lineEnd, pFaceSize) || *pFaceSize < 3) {
+        return false;
+    }
+
+    if(*pFaceSize > PLY_MAX_FACE_INDICES) {
+        return valid;
+    }
 
-            pData->mJoinedMesh.mNormals[(pData->mJoinedMesh.mMeshSize - pData->mMeshes[i].mMeshSize) + j * 3 + 0] = pData->mMeshes[i].mNormals[j * 3 + 0];
-            pData->mJoinedMesh.mNormals[(pData->mJoinedMesh.mMeshSize - pData->mMeshes[i].mMeshSize) + j * 3 + 1] = pData->mMeshes[i].mNormals[j * 3 + 1];
-            pData->mJoinedMesh.mNormals[(pData->mJoinedMesh.mMeshSize - pData->mMeshes[i].mMeshSize) + j * 3 + 2] = pData->mMeshes[i].mNormals[j * 3 + 2];
+    for(uint32_t j = 0; j < *pFaceSize; j++) {
+        valid &= CParseUInt(&line, lineEnd, &face[j]);
+    }
 
-            pData->mJoinedMesh.mColors[(pData->mJoinedMesh.mMeshSize - pData->mMeshes[i].mMeshSize) + j * 4 + 0] = pData->mMeshes[i].mColors[j * 4 + 0];
-            pData->mJoinedMesh.mColors[(pData->mJoinedMesh.mMeshSize - pData->mMeshes[i].mMeshSize) + j * 4 + 1] = pData->mMeshes[i].mColors[j * 4 + 1];
-            pData->mJoinedMesh.mColors[(pData->mJoinedMesh.mMeshSize - pData->mMeshes[i].mMeshSize) + j * 4 + 2] = pData->mMeshes[i].mColors[j * 4 + 2];
-            pData->mJoinedMesh.mColors[(pData->mJoinedMesh.mMeshSize - pData->mMeshes[i].mMeshSize) + j * 4 + 3] = pData->mMeshes[i].mColors[j * 4 + 3];
+    return valid;
+}
 
-            pData->mJoinedMesh.mTextureCoordinates[(pData->mJoinedMesh.mMeshSize - pData->mMeshes[i].mMeshSize) + j * 2 + 0] = pData->mMeshes[i].mTextureCoordinates[j * 2 + 0];
-            pData->mJoinedMesh.mTextureCoordinates[(pData->mJoinedMesh.mMeshSize - pData->mMeshes[i].mMeshSize) + j * 2 + 1] = pData->mMeshes[i].mTextureCoordinates[j * 2 + 1];
+typedef struct PLYASCIIChunk_s {
+    const uint8_t* mStart;
+    const uint8_t* mEnd;
+    size_t mFirstLine;
+    size_t mLineCount;
+    size_t mFirstCorner;
+    size_t mCornerCount;
+    bool mMalformed;
+} PLYASCIIChunk_t;
+
+typedef struct PLYASCIIDecoder_s {
+    const PLYHeader_t* mHeader;
+    PLYASCIIChunk_t* mChunks;
+    Mesh_t* mMesh;
+    const Mesh_t* mTemp;
+    const PLYVertexField_t* mFields;
+    size_t mElementFirstLine[PLY_MAX_ELEMENTS];
+    int32_t mVertexElement;
+    int32_t mFaceElement;
+    int32_t mFaceIndices;
+    bool mIndexed;
+    bool mEmit;
+} PLYASCIIDecoder_t;
+
+void __MPLYCountLinesJob(void* pArgs, uint32_t job) {
+    PLYASCIIChunk_t* chunk = &((PLYASCIIDecoder_t*)pArgs)->mChunks[job];
+    const uint8_t* cursor = chunk->mStart;
+
+    chunk->mLineCount = 0;
+
+    while(cursor < chunk->mEnd) {
+        const uint8_t* line_end = (const uint8_t*)memchr(cursor, '\n', chunk->mEnd - cursor);
+
+        chunk->mLineCount++;
+
+        if(line_end == nullptr) {
+            break;
         }
+
+        cursor = line_end + 1;
     }
 }
 
-void MDAddMesh(MeshData_t* pData, Mesh_t mesh) {
-    pData->mMeshes = MECRealloc(pData->mMeshes, sizeof(Mesh_t) * (++pData->mMeshCount));
-    pData->mMeshes[pData->mMeshCount - 1] = mesh;
-    pData->mMeshTransform = MECRealloc(pData->mMeshTransform, sizeof(Transform_t) * pData->mMeshCount);
-    pData->mTextureID = MECRealloc(pData->mTextureID, sizeof(float) * ((pData->mMeshCount <= 1 ? 0 : (pData->mMeshStart[pData->mMeshCount - 2] + pData->mMeshes[pData->mMeshCount - 2].mMeshSize)) + pData->mMeshes[pData->mMeshCount - 1].mMeshSize));
+/**
+ * @brief Decodes one newline aligned chunk of ASCII body. First pass parses vertices and counts output vertices of faces, second pass (mEmit) writes faces at chunk output offset
+ * 
+ * @param pArgs PLYASCIIDecoder_t pointer
+ * @param job chunk index
+ */
+void __MPLYDecodeASCIIJob(void* pArgs, uint32_t job) {
+    PLYASCIIDecoder_t* decoder = (PLYASCIIDecoder_t*)pArgs;
+    PLYASCIIChunk_t* chunk = &decoder->mChunks[job];
+    const PLYHeader_t* header = decoder->mHeader;
+    const uint8_t* cursor = chunk->mStart;
+    size_t line_index = chunk->mFirstLine;
+    size_t output = chunk->mFirstCorner;
+    uint32_t e = 0;
+
+    if(!decoder->mEmit) {
+        chunk->mCornerCount = 0;
+    }
+
+    while(cursor < chunk->mEnd) {
+        const uint8_t* line_end = (const uint8_t*)memchr(cursor, '\n', chunk->mEnd - cursor);
+        if(line_end == nullptr) line_end = chunk->mEnd;
+
+        const char* line = (const char*)cursor;
+        const char* line_stop = (const char*)line_end;
+
+        cursor = line_end + 1;
+
+        while(e < header->mElementCount && line_index >= decoder->mElementFirstLine[e] + header->mElements[e].mCount) e++;
+
+        if(e >= header->mElementCount) {
+            break;
+        }
+
+        size_t record = line_index++ - decoder->mElementFirstLine[e];
+
+        if((int32_t)e == decoder->mVertexElement && !decoder->mEmit) {
+            chunk->mMalformed |= !__MPLYParseASCIIVertex(&header->mElements[e], decoder->mFields, record, line, line_stop);
+        }
+        else if((int32_t)e == decoder->mFaceElement && decoder->mFaceIndices >= 0) {
+            uint32_t face[PLY_MAX_FACE_INDICES];
+            uint32_t face_size = 0;
+
+            if(!__MPLYParseASCIIFace(&header->mElements[e], decoder->mFaceIndices, line, line_stop, face, &face_size)) {
+                chunk->mMalformed = true;
+
+                continue;
+            }
 
-    TFSetScale(&pData->mMeshTransform[pData->mMeshCount - 1], (vec4_t){1.0, 1.0, 1.0, 1.0});
+            if(!__MPLYFaceValid(decoder->mTemp, face, face_size)) {
+                if(decoder->mEmit) {
+                    E_WARN_ARG("Face %zu index is out of %zu vertices or face has more than %d indices, skipping face!", record, decoder->mTemp->mMeshSize, PLY_MAX_FACE_INDICES);
+                }
+
+                continue;
+            }
+
+            if(decoder->mEmit) {
+                output += __MPLYWriteFace(decoder->mMesh, output, decoder->mTemp, face, face_size, decoder->mIndexed);
+            }
+            else {
+                chunk->mCornerCount += __MPLYFaceCorners(face_size);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Decodes whole ASCII body. Body is split into newline aligned chunks that are parsed in parallel, vertices first and faces after prefix sum of per chunk output sizes
+ * 
+ * @param pMesh output mesh
+ * @param pTemp vertex table
+ * @param pHeader .ply header
+ * @param fields vertex decode table
+ * @param body body start
+ * @param end source end
+ * @param indexed write face indices instead of vertices
+ * @return false when body is malformed or shorter than header declares
+ */
+bool __MPLYDecodeASCII(Mesh_t* pMesh, const Mesh_t* pTemp, const PLYHeader_t* pHeader, const PLYVertexField_t* fields, const uint8_t* body, const uint8_t* end, bool indexed) {
+    PLYASCIIDecoder_t decoder;
+    memset(&decoder, 0, sizeof(PLYASCIIDecoder_t));
+
+    decoder.mHeader = pHeader;
+    decoder.mMesh = pMesh;
+    decoder.mTemp = pTemp;
+    decoder.mFields = fields;
+    decoder.mIndexed = indexed;
+    decoder.mVertexElement = PLYFindElement(pHeader, "vertex");
+    decoder.mFaceElement = PLYFindElement(pHeader, "face");
+    decoder.mFaceIndices = decoder.mFaceElement < 0 ? -1 : __MPLYFindFaceIndices(&pHeader->mElements[decoder.mFaceElement]);
+
+    size_t total_lines = 0;
+
+    for(uint32_t e = 0; e < pHeader->mElementCount; e++) {
+        decoder.mElementFirstLine[e] = total_lines;
+        total_lines += pHeader->mElements[e].mCount;
+    }
+
+    const size_t min_chunk_size = 1 << 20;
+    size_t body_size = (size_t)(end - body);
+    uint32_t thread_count = MTGetThreadCount();
+    uint32_t chunk_count = thread_count <= 1 ? 1 : (uint32_t)(body_size / min_chunk_size < (size_t)thread_count * 4 ? body_size / min_chunk_size : (size_t)thread_count * 4);
+    if(chunk_count == 0) chunk_count = 1;
+
+    decoder.mChunks = (PLYASCIIChunk_t*)MECCalloc(chunk_count, sizeof(PLYASCIIChunk_t));
+
+    const uint8_t* chunk_start = body;
+
+    for(uint32_t i = 0; i < chunk_count; i++) {
+        const uint8_t* chunk_end = i + 1 == chunk_count ? end : body + body_size / chunk_count * (i + 1);
 
-    MECFree(pData->mMeshStart);
-    __MDCalculateMeshEnds(pData);
+        if(chunk_end < chunk_start) chunk_end = chunk_start;
 
-    for(uint32_t i = 0; i < pData->mMeshes[pData->mMeshCount - 1].mMeshSize; i++) {
-        pData->mTextureID[(pData->mMeshCount <= 1 ? 0 : (pData->mMeshStart[pData->mMeshCount - 2] + pData->mMeshes[pData->mMeshCount - 2].mMeshSize)) + i] = 33.0f;
+        if(chunk_end < end) {
+            const uint8_t* new_line = (const uint8_t*)memchr(chunk_end, '\n', end - chunk_end);
+            chunk_end = new_line == nullptr ? end : new_line + 1;
+        }
+
+        decoder.mChunks[i].mStart = chunk_start;
+        decoder.mChunks[i].mEnd = chunk_end;
+        chunk_start = chunk_end;
+    }
+
+    MTParallelFor(chunk_count, __MPLYCountLinesJob, &decoder);
+
+    size_t lines = 0;
+
+    for(uint32_t i = 0; i < chunk_count; i++) {
+        decoder.mChunks[i].mFirstLine = lines;
+        lines += decoder.mChunks[i].mLineCount;
     }
 
-    MAllocMesh(&pData->mJoinedMesh, pData->mJoinedMesh.mMeshSize + pData->mMeshes[pData->mMeshCount - 1].mMeshSize);
+    MTParallelFor(chunk_count, __MPLYDecodeASCIIJob, &decoder);
 
-    for(uint32_t j = 0; j < pData->mMeshes[pData->mMeshCount - 1].mMeshSize; j++) {
-        vec4_t mat_pos = MX4MulV(pData->mMeshTransform[pData->mMeshCount - 1].mTransformMat, (vec4_t){pData->mMeshes[pData->mMeshCount - 1].mVertices[j * 3 + 0], pData->mMeshes[pData->mMeshCount - 1].mVertices[j * 3 + 1], pData->mMeshes[pData->mMeshCount - 1].mVertices[j * 3 + 2], 1.0});
+    size_t corners = indexed ? pMesh->mIndexCount : pMesh->mMeshSize;
+    bool malformed = lines < total_lines;
 
-        pData->mJoinedMesh.mVertices[(pData->mJoinedMesh.mMeshSize - pData->mMeshes[pData->mMeshCount - 1].mMeshSize) + j * 3 + 0] = mat_pos.x;
-        pData->mJoinedMesh.mVertices[(pData->mJoinedMesh.mMeshSize - pData->mMeshes[pData->mMeshCount - 1].mMeshSize) + j * 3 + 1] = mat_pos.y;
-        pData->mJoinedMesh.mVertices[(pData->mJoinedMesh.mMeshSize - pData->mMeshes[pData->mMeshCount - 1].mMeshSize) + j * 3 + 2] = mat_pos.z;
+    for(uint32_t i = 0; i < chunk_count; i++) {
+        decoder.mChunks[i].mFirstCorner = corners;
+        corners += decoder.mChunks[i].mCornerCount;
+        malformed |= decoder.mChunks[i].mMalformed;
+    }
 
-        pData->mJoinedMesh.mNormals[(pData->mJoinedMesh.mMeshSize - pData->mMeshes[pData->mMeshCount - 1].mMeshSize) + j * 3 + 0] = pData->mMeshes[pData->mMeshCount - 1].mNormals[j * 3 + 0];
-        pData->mJoinedMesh.mNormals[(pData->mJoinedMesh.mMeshSize - pData->mMeshes[pData->mMeshCount - 1].mMeshSize) + j * 3 + 1] = pData->mMeshes[pData->mMeshCount - 1].mNormals[j * 3 + 1];
-        pData->mJoinedMesh.mNormals[(pData->mJoinedMesh.mMeshSize - pData->mMeshes[pData->mMeshCount - 1].mMeshSize) + j * 3 + 2] = pData->mMeshes[pData->mMeshCount - 1].mNormals[j * 3 + 2];
+    if(indexed) {
+        MReserveIndices(pMesh, corners);
+    }
+    else {
+        MReserveMesh(pMesh, corners);
+    }
 
-        pData->mJoinedMesh.mColors[(pData->mJoinedMesh.mMeshSize - pData->mMeshes[pData->mMeshCount - 1].mMeshSize) + j * 4 + 0] = pData->mMeshes[pData->mMeshCount - 1].mColors[j * 4 + 0];
-        pData->mJoinedMesh.mColors[(pData->mJoinedMesh.mMeshSize - pData->mMeshes[pData->mMeshCount - 1].mMeshSize) + j * 4 + 1] = pData->mMeshes[pData->mMeshCount - 1].mColors[j * 4 + 1];
-        pData->mJoinedMesh.mColors[(pData->mJoinedMesh.mMeshSize - pData->mMeshes[pData->mMeshCount - 1].mMeshSize) + j * 4 + 2] = pData->mMeshes[pData->mMeshCount - 1].mColors[j * 4 + 2];
-        pData->mJoinedMesh.mColors[(pData->mJoinedMesh.mMeshSize - pData->mMeshes[pData->mMeshCount - 1].mMeshSize) + j * 4 + 3] = pData->mMeshes[pData->mMeshCount - 1].mColors[j * 4 + 3];
+    decoder.mEmit = true;
+    MTParallelFor(chunk_count, __MPLYDecodeASCIIJob, &decoder);
 
-        pData->mJoinedMesh.mTextureCoordinates[(pData->mJoinedMesh.mMeshSize - pData->mMeshes[pData->mMeshCount - 1].mMeshSize) + j * 2 + 0] = pData->mMeshes[pData->mMeshCount - 1].mTextureCoordinates[j * 2 + 0];
-        pData->mJoinedMesh.mTextureCoordinates[(pData->mJoinedMesh.mMeshSize - pData->mMeshes[pData->mMeshCount - 1].mMeshSize) + j * 2 + 1] = pData->mMeshes[pData->mMeshCount - 1].mTextureCoordinates[j * 2 + 1];
+    if(indexed) {
+        pMesh->mIndexCount = corners;
+    }
+    else {
+        pMesh->mMeshSize = corners;
     }
+
+    MECFree(decoder.mChunks);
+
+    return !malformed;
 }
 
-typedef struct RenderData_s {
-    MeshData_t* mMeshPtr;
+typedef struct PLYCopyRun_s {
+    float* mStream;
+    uint32_t mStride;
+    uint32_t mOffset;
+    uint32_t mSize;
+} PLYCopyRun_t;
+
+/**
+ * @brief Bulk decoder of fixed size binary vertex records. Float properties that lie next to each other in record and in mesh stream are copied as one run (big endian records are byte swapped in chunks first), other mapped properties are converted by reader of their decode table entry
+ * 
+ * @param pElement vertex element
+ * @param fields vertex decode table
+ * @param src first record
+ * @param swap true when records endianess differs from host
+ */
+void __MPLYDecodeBinaryVertices(const PLYElement_t* pElement, const PLYVertexField_t* fields, const uint8_t* src, bool swap) {
+    PLYCopyRun_t runs[PLY_MAX_PROPERTIES];
+    const PLYVertexField_t* converted[PLY_MAX_PROPERTIES];
+    uint32_t run_count = 0, converted_count = 0;
+    bool words_only = true;
+
+    for(uint32_t p = 0; p < pElement->mPropertyCount; p++) {
+        const PLYProperty_t* property = &pElement->mProperties[p];
+        const PLYVertexField_t* field = &fields[p];
+
+        if(PLYTypeSize(property->mType) != 4) {
+            words_only = false;
+        }
 
-    VArray_t mVArray;
-    VBuffer_t mVerticesBuffer, mColorBuffer, mNormalBuffer, mTextureCoordinatesBuffer, mTextureIDBuffer;
-    TextureArray_t *mTexturesPtr[32];
-} RenderData_t;
+        if(field->mStream == nullptr) {
+            continue;
+        }
 
-void RDUpdateMesh(RenderData_t* pRd) {
-    VABind(&pRd->mVArray);
+        if(property->mType != PLY_TYPE_FLOAT || field->mScale != 1.0f) {
+            converted[converted_count++] = field;
 
-    VBBindData(&pRd->mVerticesBuffer, pRd->mMeshPtr->mJoinedMesh.mVertices, /*sizeof(float) */ (pRd->mMeshPtr->mJoinedMesh.mMeshSize - 1) * 3);
-    printf("Debug\n"); fflush(stdout);
-    VBBindData(&pRd->mColorBuffer, pRd->mMeshPtr->mJoinedMesh.mVertices, sizeof(float) * pRd->mMeshPtr->mJoinedMesh.mMeshSize * 4);
-    VBBindData(&pRd->mNormalBuffer, pRd->mMeshPtr->mJoinedMesh.mVertices, sizeof(float) * pRd->mMeshPtr->mJoinedMesh.mMeshSize * 3);
-    VBBindData(&pRd->mTextureCoordinatesBuffer, pRd->mMeshPtr->mJoinedMesh.mVertices, sizeof(float) * pRd->mMeshPtr->mJoinedMesh.mMeshSize * 2);
-    VBBindData(&pRd->mTextureIDBuffer, pRd->mMeshPtr->mTextureID, sizeof(float) * pRd->mMeshPtr->mJoinedMesh.mMeshSize);
-
-    VBBindPlace(&pRd->mVerticesBuffer, 0, 3);
-    VBBindPlace(&pRd->mColorBuffer, 1, 4);
-    VBBindPlace(&pRd->mNormalBuffer, 2, 3);
-    VBBindPlace(&pRd->mTextureCoordinatesBuffer, 3, 2);
-    VBBindPlace(&pRd->mTextureIDBuffer, 4, 1);
-    
-    VAUnbind();
+            continue;
+        }
+
+        PLYCopyRun_t* last = run_count == 0 ? nullptr : &runs[run_count - 1];
+
+        if(last != nullptr && last->mStream + last->mSize == field->mStream && last->mStride == field->mStride && last->mOffset + last->mSize * sizeof(float) == property->mOffset) {
+            last->mSize++;
+
+            continue;
+        }
+
+        runs[run_count++] = (PLYCopyRun_t){ field->mStream, field->mStride, property->mOffset, 1 };
+    }
+
+    if(run_count == 0 && converted_count == 0) {
+        return;
+    }
+
+    const size_t stride = pElement->mStride;
+    const size_t chunk_records = 4096;
+    uint8_t* scratch = swap && run_count != 0 ? (uint8_t*)MECMalloc(chunk_records * stride) : nullptr;
+
+    for(size_t first = 0; first < pElement->mCount; first += chunk_records) {
+        size_t chunk = pElement->mCount - first < chunk_records ? pElement->mCount - first : chunk_records;
+        const uint8_t* source = src + first * stride;
+        const uint8_t* records = source;
+
+        for(uint32_t k = 0; k < converted_count; k++) {
+            const PLYVertexField_t* field = converted[k];
+            float* dst = field->mStream + first * field->mStride;
+            const uint8_t* record = source + field->mOffset;
+
+            for(size_t r = 0; r < chunk; r++) {
+                dst[r * field->mStride] = field->mRead(record + r * stride) * field->mScale;
+            }
+        }
+
+        if(scratch != nullptr) {
+            if(words_only) {
+                PLYSwapBytes32(scratch, records, chunk * stride / sizeof(uint32_t));
+            }
+            else {
+                memcpy(scratch, records, chunk * stride);
+
+                for(size_t r = 0; r < chunk; r++) {
+                    for(uint32_t k = 0; k < run_count; k++) {
+                        PLYSwapBytes32(scratch + r * stride + runs[k].mOffset, scratch + r * stride + runs[k].mOffset, runs[k].mSize);
+                    }
+                }
+            }
+
+            records = scratch;
+        }
+
+        for(uint32_t k = 0; k < run_count; k++) {
+            const PLYCopyRun_t* run = &runs[k];
+            float* dst = run->mStream + first * run->mStride;
+            const uint8_t* record = records + run->mOffset;
+
+            switch(run->mSize) {
+                case 3:
+                    for(size_t r = 0; r < chunk; r++) memcpy(dst + r * run->mStride, record + r * stride, sizeof(float) * 3);
+                    break;
+                case 2:
+                    for(size_t r = 0; r < chunk; r++) memcpy(dst + r * run->mStride, record + r * stride, sizeof(float) * 2);
+                    break;
+                default:
+                    for(size_t r = 0; r < chunk; r++) memcpy(dst + r * run->mStride, record + r * stride, sizeof(float) * run->mSize);
+                    break;
+            }
+        }
+    }
+
+    if(scratch != nullptr) {
+        MECFree(scratch);
+    }
+}
+
+/**
+ * @brief Reads vertex index list of complete binary face record
+ * 
+ * @param pElement face element
+ * @param faceIndices vertex index list property
+ * @param record record start
+ * @param bigEndian source endianess
+ * @param face output indices (PLY_MAX_FACE_INDICES max), nullptr to read only face size
+ * @return uint32_t declared face indices amount
+ */
+uint32_t __MPLYReadBinaryFace(const PLYElement_t* pElement, int32_t faceIndices, const uint8_t* record, bool bigEndian, uint32_t* face) {
+    const PLYProperty_t* property = &pElement->mProperties[faceIndices];
+
+    for(int32_t p = 0; p < faceIndices; p++) {
+        record += pElement->mProperties[p].mList ? PLYTypeSize(pElement->mProperties[p].mCountType) + PLYTypeSize(pElement->mProperties[p].mType) * PLYReadIndex(record, pElement->mProperties[p].mCountType, bigEndian) : PLYTypeSize(pElement->mProperties[p].mType);
+    }
+
+    uint32_t face_size = PLYReadIndex(record, property->mCountType, bigEndian);
+
+    record += PLYTypeSize(property->mCountType);
+
+    for(uint32_t j = 0; face != nullptr && j < face_size && j < PLY_MAX_FACE_INDICES; j++) {
+        face[j] = PLYReadIndex(record + j * PLYTypeSize(property->mType), property->mType, bigEndian);
+    }
+
+    return face_size;
+}
+
+/**
+ * @brief Decodes binary face element records. With pMesh equal to nullptr only counts output vertices, so loader can reserve mesh once before emitting
+ * 
+ * @param pMesh output mesh or nullptr for counting pass
+ * @param pSrc vertex table
+ * @param pElement face element
+ * @param faceIndices vertex index list property
+ * @param bigEndian source endianess
+ * @param cursor first record
+ * @param end source end
+ * @param pCorners output vertex count
+ * @param indexed write face indices instead of vertices
+ * @return const uint8_t* end of element or nullptr when element overflows source
+ */
+const uint8_t* __MPLYDecodeFaces(Mesh_t* pMesh, const Mesh_t* pSrc, const PLYElement_t* pElement, int32_t faceIndices, bool bigEndian, const uint8_t* cursor, const uint8_t* end, size_t* pCorners, bool indexed) {
+    for(size_t r = 0; r < pElement->mCount; r++) {
+        const uint8_t* record = cursor;
+
+        cursor = __MPLYSkipBinaryRecord(pElement, cursor, end, bigEndian);
+
+        if(cursor == nullptr) {
+            return nullptr;
+        }
+
+        uint32_t face[PLY_MAX_FACE_INDICES];
+        uint32_t faces_value_amount = __MPLYReadBinaryFace(pElement, faceIndices, record, bigEndian, pMesh == nullptr ? nullptr : face);
+
+        if(faces_value_amount < 3) {
+            continue;
+        }
+
+        if(pMesh == nullptr) {
+            *pCorners += __MPLYFaceCorners(faces_value_amount);
+
+            continue;
+        }
+
+        __MPLYEmitFace(pMesh, pSrc, face, faces_value_amount, indexed);
+    }
+
+    return cursor;
+}
+
+/**
+ * @brief Skips binary element records without decoding them
+ * 
+ * @param pElement element pointer
+ * @param bigEndian source endianess
+ * @param cursor first record
+ * @param end source end
+ * @return const uint8_t* end of element or nullptr when element overflows source
+ */
+const uint8_t* __MPLYSkipElement(const PLYElement_t* pElement, bool bigEndian, const uint8_t* cursor, const uint8_t* end) {
+    if(pElement->mFixedSize) {
+        if((size_t)(end - cursor) / (pElement->mStride == 0 ? 1 : pElement->mStride) < pElement->mCount) {
+            return nullptr;
+        }
+
+        return cursor + pElement->mCount * pElement->mStride;
+    }
+
+    for(size_t r = 0; r < pElement->mCount && cursor != nullptr; r++) {
+        cursor = __MPLYSkipBinaryRecord(pElement, cursor, end, bigEndian);
+    }
+
+    return cursor;
+}
+
+/**
+ * @brief Check that binary vertex records can be decoded. Records with list properties have variable size and are not decoded, vertex element of zero stride (no properties) would divide record sizes by zero
+ * 
+ * @param pHeader parsed header
+ * @param vertexElement vertex element index, -1 when there is none
+ * @return true when vertices can be decoded
+ */
+bool __MPLYCheckBinaryVertices(const PLYHeader_t* pHeader, int32_t vertexElement) {
+    if(pHeader->mFormat == PLY_FORMAT_ASCII || vertexElement < 0 || pHeader->mElements[vertexElement].mCount == 0) {
+        return true;
+    }
+
+    const PLYElement_t* element = &pHeader->mElements[vertexElement];
+
+    if(!element->mFixedSize) {
+        E_WARN("Binary vertex element has list property, model is not loaded!");
+
+        return false;
+    }
+
+    if(element->mStride == 0) {
+        E_WARN("Binary vertex element has no properties, model is not loaded!");
+
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Loads .ply model from memory and appends it to mesh
+ * 
+ * @param pMesh mesh pointer
+ * @param src .ply file contents
+ * @param size .ply file size
+ * @param indexed keep vertex table and write face indices instead of expanding every face corner
+ * @return true when model was loaded
+ */
+bool __MLoadPLYMesh(Mesh_t* pMesh, const uint8_t* src, size_t size, bool indexed) {
+    PLYHeader_t header;
+
+    if(!PLYParseHeader(&header, src, size)) {
+        return false;
+    }
+
+    int32_t vertex_element = PLYFindElement(&header, "vertex");
+    int32_t face_element = PLYFindElement(&header, "face");
+    size_t vertex_amount = vertex_element < 0 ? 0 : header.mElements[vertex_element].mCount;
+
+    if(!__MPLYCheckBinaryVertices(&header, vertex_element)) {
+        return false;
+    }
+
+    E_INFO_ARG("Model data: %zu vertex, %zu faces", vertex_amount, face_element < 0 ? 0 : header.mElements[face_element].mCount);
+
+    Mesh_t temp;
+    MClearMesh(&temp);
+    MAllocMesh(&temp, vertex_amount);
+
+    PLYVertexField_t fields[PLY_MAX_PROPERTIES];
+    bool big_endian = header.mFormat == PLY_FORMAT_BINARY_BIG_ENDIAN;
+
+    if(vertex_element >= 0) {
+        __MPLYMapVertexProperties(&header.mElements[vertex_element], &temp, fields, big_endian != PLY_HOST_BIG_ENDIAN);
+        __MPLYClearUnmappedStreams(&header.mElements[vertex_element], &temp, fields, vertex_amount);
+    }
+
+    const uint8_t* cursor = src + header.mHeaderSize;
+    const uint8_t* body_end = src + size;
+    bool malformed = false;
+    size_t first_vertex = pMesh->mMeshSize;
+
+    // ASCII decoder parses all vertices before it emits any face
+    if(header.mFormat == PLY_FORMAT_ASCII) {
+        malformed = !__MPLYDecodeASCII(pMesh, &temp, &header, fields, cursor, body_end, indexed);
+    }
+
+    // binary vertex element is decoded before faces, face element may come in front of it and would be triangulated from unread positions
+    for(int32_t e = 0; e <= vertex_element && header.mFormat != PLY_FORMAT_ASCII && cursor != nullptr; e++) {
+        const PLYElement_t* element = &header.mElements[e];
+
+        if(e == vertex_element && element->mFixedSize && element->mStride != 0) {
+            if((size_t)(body_end - cursor) / element->mStride < element->mCount) {
+                cursor = nullptr;
+            }
+            else {
+                __MPLYDecodeBinaryVertices(element, fields, cursor, big_endian != PLY_HOST_BIG_ENDIAN);
+            }
+        }
+        else {
+            cursor = __MPLYSkipElement(element, big_endian, cursor, body_end);
+        }
+
+        if(cursor == nullptr) {
+            E_WARN_ARG("Model body ends in the middle of \"%s\" data!", element->mName);
+        }
+    }
+
+    if(cursor != nullptr) {
+        cursor = src + header.mHeaderSize;
+    }
+
+    for(uint32_t e = 0; e < header.mElementCount && header.mFormat != PLY_FORMAT_ASCII && cursor != nullptr; e++) {
+        const PLYElement_t* element = &header.mElements[e];
+        int32_t face_indices = (int32_t)e == face_element ? __MPLYFindFaceIndices(element) : -1;
+
+        if(face_indices >= 0) {
+            size_t corners = 0;
+
+            if(__MPLYDecodeFaces(nullptr, &temp, element, face_indices, big_endian, cursor, body_end, &corners, indexed) != nullptr) {
+                if(indexed) {
+                    MReserveIndices(pMesh, pMesh->mIndexCount + corners);
+                }
+                else {
+                    MReserveMesh(pMesh, pMesh->mMeshSize + corners);
+                }
+            }
+
+            cursor = __MPLYDecodeFaces(pMesh, &temp, element, face_indices, big_endian, cursor, body_end, &corners, indexed);
+        }
+        else {
+            cursor = __MPLYSkipElement(element, big_endian, cursor, body_end);
+        }
+
+        if(cursor == nullptr) {
+            E_WARN_ARG("Model body ends in the middle of \"%s\" data!", element->mName);
+        }
+    }
+
+    if(malformed) {
+        E_WARN("Some .ply values could not be parsed or are missing, they are set to 0!");
+    }
+
+    if(indexed && first_vertex == 0) {
+        uint32_t* indices = pMesh->mIndices;
+        size_t index_count = pMesh->mIndexCount;
+        size_t index_capacity = pMesh->mIndexCapacity;
+
+        if(pMesh->mMeshCapacity != 0) {
+            pMesh->mIndices = nullptr;
+            MFreeMesh(pMesh);
+        }
+
+        *pMesh = temp;
+        pMesh->mIndices = indices;
+        pMesh->mIndexCount = index_count;
+        pMesh->mIndexCapacity = index_capacity;
+    }
+    else {
+        if(indexed) {
+            MAllocMesh(pMesh, first_vertex + temp.mMeshSize);
+
+            memcpy(&pMesh->mVertices[first_vertex * 3], temp.mVertices, temp.mMeshSize * sizeof(float) * 3);
+            memcpy(&pMesh->mNormals[first_vertex * 3], temp.mNormals, temp.mMeshSize * sizeof(float) * 3);
+            memcpy(&pMesh->mTextureCoordinates[first_vertex * 2], temp.mTextureCoordinates, temp.mMeshSize * sizeof(float) * 2);
+            memcpy(&pMesh->mColors[first_vertex * 4], temp.mColors, temp.mMeshSize * sizeof(float) * 4);
+        }
+
+        MFreeMesh(&temp);
+    }
+
+    MCalculateBounds(pMesh);
+
+    return true;
+}
+
+/**
+ * @brief Load .ply model from memory, header and body are parsed straight from source (source don`t need to be null terminated). Every face corner becomes own vertex
+ * 
+ * @param pMesh mesh pointer
+ * @param src .ply file contents
+ * @param size .ply file size
+ * @return true when model was loaded
+ */
+bool MLoadPLYMeshFromMemory(Mesh_t* pMesh, const uint8_t* src, size_t size) {
+    return __MLoadPLYMesh(pMesh, src, size, false);
+}
+
+/**
+ * @brief Load .ply model from memory as indexed mesh, vertex table is kept as is and faces are written to mesh indices
+ * 
+ * @param pMesh mesh pointer
+ * @param src .ply file contents
+ * @param size .ply file size
+ * @return true when model was loaded
+ */
+bool MLoadPLYIndexedMeshFromMemory(Mesh_t* pMesh, const uint8_t* src, size_t size) {
+    return __MLoadPLYMesh(pMesh, src, size, true);
+}
+
+/**
+ * @brief Maps .ply file and loads it
+ * 
+ * @param pMesh mesh pointer
+ * @param path .ply file path
+ * @param indexed load as indexed mesh
+ */
+void __MLoadPLYMeshFromFile(Mesh_t* pMesh, const char* path, bool indexed) {
+    FileMap_t mesh_file;
+
+    if(!FMOpen(&mesh_file, path)) {
+        return;
+    }
+
+    if(!__MLoadPLYMesh(pMesh, mesh_file.mData, mesh_file.mSize, indexed)) {
+        E_WARN_ARG("Cannot load model \"%s\"!", path);
+    }
+
+    FMClose(&mesh_file);
+}
+
+/**
+ * @brief Load .ply model from file, file is memory mapped once and parsed without second pass through stdio
+ * 
+ * @param pMesh mesh pointer
+ * @param path .ply file path
+ */
+void MLoadPLYMeshFromFile(Mesh_t* pMesh, const char* path) {
+    __MLoadPLYMeshFromFile(pMesh, path, false);
+}
+
+/**
+ * @brief Load .ply model from file as indexed mesh (see MLoadPLYIndexedMeshFromMemory)
+ * 
+ * @param pMesh mesh pointer
+ * @param path .ply file path
+ */
+void MLoadPLYIndexedMeshFromFile(Mesh_t* pMesh, const char* path) {
+    __MLoadPLYMeshFromFile(pMesh, path, true);
+}
+
+#define M_PLY_STREAM_WINDOW (4 << 20)
+#define M_PLY_STREAM_BATCH 65536
+
+typedef struct MeshBatch_s {
+    const Mesh_t* mVertices;
+    size_t mFirstVertex;
+
+    const uint32_t* mIndices;
+    size_t mIndexCount;
+    size_t mFirstIndex;
+} MeshBatch_t;
+
+/**
+ * @brief Streaming loader callback, batch contains either vertices (mVertices != nullptr) or triangle indices relative to first streamed vertex. Batch memory is reused after callback returns
+ */
+typedef void (*PFN_MStreamCallback)(void* pUser, const MeshBatch_t* pBatch);
+
+typedef struct PLYStream_s {
+    FILE* mFile;
+    uint8_t* mWindow;
+    size_t mWindowSize;
+    size_t mBegin;
+    size_t mEnd;
+    bool mEof;
+} PLYStream_t;
+
+/**
+ * @brief Moves unread window bytes to window start and reads file into free space
+ * 
+ * @param pStream stream pointer
+ * @return true when new bytes were read
+ */
+bool __MPLYStreamFill(PLYStream_t* pStream) {
+    if(pStream->mEof || (pStream->mBegin == 0 && pStream->mEnd == pStream->mWindowSize)) {
+        return false;
+    }
+
+    memmove(pStream->mWindow, pStream->mWindow + pStream->mBegin, pStream->mEnd - pStream->mBegin);
+    pStream->mEnd -= pStream->mBegin;
+    pStream->mBegin = 0;
+
+    size_t read = fread(pStream->mWindow + pStream->mEnd, 1, pStream->mWindowSize - pStream->mEnd, pStream->mFile);
+
+    pStream->mEnd += read;
+    pStream->mEof = read == 0;
+
+    return read != 0;
+}
+
+/**
+ * @brief Returns next ASCII line from window, refilling window when line is incomplete
+ * 
+ * @param pStream stream pointer
+ * @param pLineEnd output line end
+ * @return const char* line start or nullptr at end of file (or line longer than window)
+ */
+const char* __MPLYStreamLine(PLYStream_t* pStream, const char** pLineEnd) {
+    for(;;) {
+        const uint8_t* line = pStream->mWindow + pStream->mBegin;
+        const uint8_t* line_end = (const uint8_t*)memchr(line, '\n', pStream->mEnd - pStream->mBegin);
+
+        if(line_end == nullptr && !__MPLYStreamFill(pStream)) {
+            if(pStream->mBegin == pStream->mEnd || !pStream->mEof) {
+                return nullptr;
+            }
+
+            line = pStream->mWindow + pStream->mBegin;
+            line_end = pStream->mWindow + pStream->mEnd;
+        }
+        else if(line_end == nullptr) {
+            continue;
+        }
+
+        pStream->mBegin = (size_t)(line_end - pStream->mWindow) + (line_end == pStream->mWindow + pStream->mEnd ? 0 : 1);
+        *pLineEnd = (const char*)line_end;
+
+        return (const char*)line;
+    }
+}
+
+/**
+ * @brief Returns next complete binary record from window, refilling window when record is incomplete
+ * 
+ * @param pStream stream pointer
+ * @param pElement record element
+ * @param bigEndian source endianess
+ * @return const uint8_t* record start or nullptr at end of file (or record longer than window)
+ */
+const uint8_t* __MPLYStreamRecord(PLYStream_t* pStream, const PLYElement_t* pElement, bool bigEndian) {
+    for(;;) {
+        const uint8_t* record = pStream->mWindow + pStream->mBegin;
+        const uint8_t* next = __MPLYSkipBinaryRecord(pElement, record, pStream->mWindow + pStream->mEnd, bigEndian);
+
+        if(next != nullptr) {
+            pStream->mBegin = (size_t)(next - pStream->mWindow);
+
+            return record;
+        }
+
+        if(!__MPLYStreamFill(pStream)) {
+            return nullptr;
+        }
+    }
+}
+
+/**
+ * @brief Decodes fixed size binary vertex records straight from window into vertex batch, as many at once as window and batch allow
+ * 
+ * @param pStream stream pointer
+ * @param pElement vertex element
+ * @param fields vertex decode table of batch mesh
+ * @param pBatch vertex batch mesh
+ * @param swap swap bytes of properties
+ * @param remaining records left in element
+ * @return size_t amount of decoded records, 0 at end of file
+ */
+size_t __MPLYStreamBinaryVertices(PLYStream_t* pStream, const PLYElement_t* pElement, const PLYVertexField_t* fields, Mesh_t* pBatch, bool swap, size_t remaining) {
+    size_t available = (pStream->mEnd - pStream->mBegin) / pElement->mStride;
+
+    if(available == 0 && (!__MPLYStreamFill(pStream) || (available = (pStream->mEnd - pStream->mBegin) / pElement->mStride) == 0)) {
+        return 0;
+    }
+
+    size_t count = available < remaining ? available : remaining;
+    count = count < M_PLY_STREAM_BATCH - pBatch->mMeshSize ? count : M_PLY_STREAM_BATCH - pBatch->mMeshSize;
+
+    PLYVertexField_t batch_fields[PLY_MAX_PROPERTIES];
+    PLYElement_t window_element = *pElement;
+    window_element.mCount = count;
+
+    for(uint32_t p = 0; p < pElement->mPropertyCount; p++) {
+        batch_fields[p] = fields[p];
+
+        if(fields[p].mStream != nullptr) {
+            batch_fields[p].mStream += pBatch->mMeshSize * fields[p].mStride;
+        }
+    }
+
+    __MPLYDecodeBinaryVertices(&window_element, batch_fields, pStream->mWindow + pStream->mBegin, swap);
+
+    pStream->mBegin += count * pElement->mStride;
+    pBatch->mMeshSize += count;
+
+    return count;
+}
+
+/**
+ * @brief Sends vertex batch to callback, counts streamed vertices and keeps batch positions when positions table was already read
+ * 
+ * @param pBatch vertex batch mesh
+ * @param pPositions streamed vertex count and their positions (when table exists)
+ * @param fn callback
+ * @param pUser callback user data
+ */
+void __MPLYStreamFlushVertices(Mesh_t* pBatch, Mesh_t* pPositions, PFN_MStreamCallback fn, void* pUser) {
+    if(pBatch->mMeshSize == 0) {
+        return;
+    }
+
+    if(pPositions->mVertices != nullptr) {
+        memcpy(&pPositions->mVertices[pPositions->mMeshSize * 3], pBatch->mVertices, pBatch->mMeshSize * sizeof(float) * 3);
+    }
+
+    MeshBatch_t batch = { pBatch, pPositions->mMeshSize, nullptr, 0, 0 };
+    fn(pUser, &batch);
+
+    pPositions->mMeshSize += pBatch->mMeshSize;
+    pBatch->mMeshSize = 0;
+}
+
+/**
+ * @brief Read positions of streamed vertices again from vertex element through own window, only positions are decoded. Runs once when first polygon has to be triangulated
+ * 
+ * @param path .ply file path
+ * @param offset file offset of vertex element body
+ * @param pHeader parsed header
+ * @param vertexElement vertex element index
+ * @param windowSize read window size in bytes
+ * @param pPositions positions table with streamed vertex count, table is allocated for whole vertex element
+ * @return true when positions were read
+ */
+bool __MPLYStreamPositions(const char* path, long offset, const PLYHeader_t* pHeader, int32_t vertexElement, size_t windowSize, Mesh_t* pPositions) {
+    const PLYElement_t* element = &pHeader->mElements[vertexElement];
+    bool ascii = pHeader->mFormat == PLY_FORMAT_ASCII;
+    bool swap = (pHeader->mFormat == PLY_FORMAT_BINARY_BIG_ENDIAN) != PLY_HOST_BIG_ENDIAN;
+
+    PLYStream_t stream;
+    memset(&stream, 0, sizeof(PLYStream_t));
+
+    stream.mFile = fopen(path, "rb");
+
+    if(stream.mFile == nullptr || fseek(stream.mFile, offset, SEEK_SET) != 0) {
+        if(stream.mFile != nullptr) {
+            fclose(stream.mFile);
+        }
+
+        return false;
+    }
+
+    stream.mWindowSize = windowSize;
+    stream.mWindow = (uint8_t*)MECMalloc(stream.mWindowSize);
+
+    Mesh_t batch;
+    MClearMesh(&batch);
+    MReserveMesh(&batch, M_PLY_STREAM_BATCH);
+
+    PLYVertexField_t fields[PLY_MAX_PROPERTIES];
+    __MPLYMapVertexProperties(element, &batch, fields, swap);
+
+    // other streams are not needed for triangulation, their properties are skipped
+    for(uint32_t p = 0; p < element->mPropertyCount; p++) {
+        if(fields[p].mStream < batch.mVertices || fields[p].mStream >= batch.mVertices + 3) {
+            fields[p].mStream = nullptr;
+        }
+    }
+
+    __MPLYClearUnmappedStreams(element, &batch, fields, M_PLY_STREAM_BATCH);
+
+    pPositions->mVertices = (float*)MECMalloc(sizeof(float) * 3 * (element->mCount + 1));
+
+    size_t read = 0;
+
+    while(read < pPositions->mMeshSize) {
+        size_t decoded = 0;
+
+        if(!ascii) {
+            decoded = __MPLYStreamBinaryVertices(&stream, element, fields, &batch, swap, pPositions->mMeshSize - read - batch.mMeshSize);
+        }
+        else {
+            const char* line_end = nullptr;
+            const char* line = __MPLYStreamLine(&stream, &line_end);
+
+            if(line != nullptr) {
+                __MPLYParseASCIIVertex(element, fields, batch.mMeshSize++, line, line_end);
+                decoded = 1;
+            }
+        }
+
+        if(decoded == 0) {
+            break;
+        }
+
+        if(batch.mMeshSize == M_PLY_STREAM_BATCH || read + batch.mMeshSize == pPositions->mMeshSize) {
+            memcpy(&pPositions->mVertices[read * 3], batch.mVertices, batch.mMeshSize * sizeof(float) * 3);
+
+            read += batch.mMeshSize;
+            batch.mMeshSize = 0;
+        }
+    }
+
+    MFreeMesh(&batch);
+    MECFree(stream.mWindow);
+    fclose(stream.mFile);
+
+    return read == pPositions->mMeshSize;
+}
+
+/**
+ * @brief Stream .ply model from file through fixed size window. Vertices and triangles are decoded in batches of M_PLY_STREAM_BATCH and passed to callback as soon as they are ready, so geometry can be uploaded before whole file is read.
+ * Besides window and batches loader keeps only count of streamed vertices, their positions are read again by second pass when first polygon with more than 3 indices has to be triangulated (triangle only models never keep them)
+ * 
+ * @param path .ply file path
+ * @param windowSize read window size in bytes, 0 for M_PLY_STREAM_WINDOW, has to hold header and longest record
+ * @param fn batch callback
+ * @param pUser callback user data
+ * @return true when whole model was streamed
+ */
+bool MStreamPLYMeshFromFile(const char* path, size_t windowSize, PFN_MStreamCallback fn, void* pUser) {
+    PLYStream_t stream;
+    memset(&stream, 0, sizeof(PLYStream_t));
+
+    stream.mFile = fopen(path, "rb");
+
+    if(stream.mFile == nullptr) {
+        E_WARN_ARG("Cannot open model \"%s\"!", path);
+
+        return false;
+    }
+
+    stream.mWindowSize = windowSize == 0 ? M_PLY_STREAM_WINDOW : windowSize;
+    stream.mWindow = (uint8_t*)MECMalloc(stream.mWindowSize);
+
+    __MPLYStreamFill(&stream);
+
+    PLYHeader_t header;
+
+    if(!PLYParseHeader(&header, stream.mWindow, stream.mEnd)) {
+        E_WARN_ARG("Cannot stream model \"%s\", header does not fit in %zu bytes window!", path, stream.mWindowSize);
+
+        MECFree(stream.mWindow);
+        fclose(stream.mFile);
+
+        return false;
+    }
+
+    stream.mBegin = header.mHeaderSize;
+
+    int32_t vertex_element = PLYFindElement(&header, "vertex");
+    int32_t face_element = PLYFindElement(&header, "face");
+    bool ascii = header.mFormat == PLY_FORMAT_ASCII;
+    bool big_endian = header.mFormat == PLY_FORMAT_BINARY_BIG_ENDIAN;
+
+    if(!__MPLYCheckBinaryVertices(&header, vertex_element)) {
+        MECFree(stream.mWindow);
+        fclose(stream.mFile);
+
+        return false;
+    }
+
+    if(face_element >= 0 && vertex_element > face_element) {
+        E_WARN_ARG("Face element of \"%s\" comes before vertex element, model can`t be streamed (load it whole)!", path);
+
+        MECFree(stream.mWindow);
+        fclose(stream.mFile);
+
+        return false;
+    }
+
+    Mesh_t positions, vertices;
+    MClearMesh(&positions);
+    MClearMesh(&vertices);
+
+    MReserveMesh(&vertices, M_PLY_STREAM_BATCH);
+
+    PLYVertexField_t fields[PLY_MAX_PROPERTIES];
+
+    if(vertex_element >= 0) {
+        __MPLYMapVertexProperties(&header.mElements[vertex_element], &vertices, fields, big_endian != PLY_HOST_BIG_ENDIAN);
+        __MPLYClearUnmappedStreams(&header.mElements[vertex_element], &vertices, fields, M_PLY_STREAM_BATCH);
+    }
+
+    uint32_t* indices = (uint32_t*)MECMalloc(sizeof(uint32_t) * (M_PLY_STREAM_BATCH * 3 + (PLY_MAX_FACE_INDICES - 2) * 3));
+    size_t index_count = 0, first_index = 0;
+    long vertex_offset = 0;
+    bool complete = true, malformed = false;
+
+    for(uint32_t e = 0; e < header.mElementCount && complete; e++) {
+        const PLYElement_t* element = &header.mElements[e];
+        int32_t face_indices = (int32_t)e == face_element ? __MPLYFindFaceIndices(element) : -1;
+
+        if((int32_t)e == vertex_element) {
+            vertex_offset = ftell(stream.mFile) - (long)(stream.mEnd - stream.mBegin);
+        }
+
+        if(!ascii && (int32_t)e == vertex_element && element->mFixedSize && element->mStride != 0) {
+            for(size_t r = 0, decoded = 0; r < element->mCount; r += decoded) {
+                decoded = __MPLYStreamBinaryVertices(&stream, element, fields, &vertices, big_endian != PLY_HOST_BIG_ENDIAN, element->mCount - r);
+
+                if(decoded == 0) {
+                    E_WARN_ARG("Model body ends in the middle of \"%s\" data!", element->mName);
+
+                    complete = false;
+
+                    break;
+                }
+
+                if(vertices.mMeshSize == M_PLY_STREAM_BATCH) {
+                    __MPLYStreamFlushVertices(&vertices, &positions, fn, pUser);
+                }
+            }
+
+            continue;
+        }
+
+        for(size_t r = 0; r < element->mCount; r++) {
+            const char* line_end = nullptr;
+            const char* line = ascii ? __MPLYStreamLine(&stream, &line_end) : nullptr;
+            const uint8_t* record = ascii ? nullptr : __MPLYStreamRecord(&stream, element, big_endian);
+
+            if(line == nullptr && record == nullptr) {
+                E_WARN_ARG("Model body ends in the middle of \"%s\" data (or record is longer than %zu bytes window)!", element->mName, stream.mWindowSize);
+
+                complete = false;
+
+                break;
+            }
+
+            if((int32_t)e == vertex_element) {
+                // binary vertices are decoded above, list properties are rejected with header
+                if(ascii) {
+                    malformed |= !__MPLYParseASCIIVertex(element, fields, vertices.mMeshSize, line, line_end);
+                }
+
+                if(++vertices.mMeshSize == M_PLY_STREAM_BATCH) {
+                    __MPLYStreamFlushVertices(&vertices, &positions, fn, pUser);
+                }
+            }
+            else if(face_indices >= 0) {
+                uint32_t face[PLY_MAX_FACE_INDICES];
+                uint32_t order[(PLY_MAX_FACE_INDICES - 2) * 3];
+                uint32_t face_size = 0;
+
+                if(ascii && !__MPLYParseASCIIFace(element, face_indices, line, line_end, face, &face_size)) {
+                    malformed = true;
+
+                    continue;
+                }
+                else if(!ascii) {
+                    face_size = __MPLYReadBinaryFace(element, face_indices, record, big_endian, face);
+                }
+
+                __MPLYStreamFlushVertices(&vertices, &positions, fn, pUser);
+
+                if(face_size < 3) {
+                    continue;
+                }
+
+                if(!__MPLYFaceValid(&positions, face, face_size)) {
+                    E_WARN_ARG("Face %zu index is out of %zu vertices or face has more than %d indices, skipping face!", r, positions.mMeshSize, PLY_MAX_FACE_INDICES);
+
+                    continue;
+                }
+
+                if(face_size > 3 && positions.mVertices == nullptr && !__MPLYStreamPositions(path, vertex_offset, &header, vertex_element, stream.mWindowSize, &positions)) {
+                    E_WARN_ARG("Cannot read vertex positions of \"%s\" again for triangulation!", path);
+
+                    complete = false;
+
+                    break;
+                }
+
+                __MPLYTriangulate(&positions, face, face_size, order);
+
+                for(uint32_t i = 0; i < __MPLYFaceCorners(face_size); i++) {
+                    indices[index_count++] = face[order[i]];
+                }
+
+                if(index_count >= M_PLY_STREAM_BATCH * 3) {
+                    MeshBatch_t batch = { nullptr, 0, indices, index_count, first_index };
+                    fn(pUser, &batch);
+
+                    first_index += index_count;
+                    index_count = 0;
+                }
+            }
+        }
+    }
+
+    __MPLYStreamFlushVertices(&vertices, &positions, fn, pUser);
+
+    if(index_count != 0) {
+        MeshBatch_t batch = { nullptr, 0, indices, index_count, first_index };
+        fn(pUser, &batch);
+    }
+
+    if(malformed) {
+        E_WARN("Some .ply values could not be parsed or are missing, they are set to 0!");
+    }
+
+    MECFree(indices);
+    MFreeMesh(&vertices);
+
+    if(positions.mVertices != nullptr) {
+        MECFree(positions.mVertices);
+    }
+
+    MECFree(stream.mWindow);
+    fclose(stream.mFile);
+
+    return complete;
+}
+
+typedef struct MeshData_s {
+    Mesh_t* mMeshes;
+    Transform_t* mMeshTransform;
+    Mesh_t mJoinedMesh;
+    Transform_t mTransform;
+    float* mTextureID;
+    float* mMeshID;
+    uint32_t* mMeshStart;
+    uint32_t* mIndexStart;
+    uint32_t* mMeshLod;
+    bool* mMeshDirty;
+    bool* mTransformDirty;
+
+    uint32_t mMeshCount;
+    uint32_t mMeshCapacity;
+    size_t mVertexIDCapacity;
+    uint32_t mDirtyCount;
+    uint32_t mTransformDirtyCount;
+
+    // joined mesh keeps model space vertices, mesh transforms are applied by vertex shader (see MDSetGPUTransforms)
+    bool mGPUTransforms;
+} MeshData_t;
+
+/**
+ * @brief Amount of indices mesh takes in joined mesh, not indexed mesh takes one index per vertex
+ * 
+ * @param pMesh mesh pointer
+ * @return size_t 
+ */
+size_t __MDMeshIndexCount(const Mesh_t* pMesh) {
+    return pMesh->mIndexCount != 0 ? pMesh->mIndexCount : pMesh->mMeshSize;
+}
+
+/**
+ * @brief Reallocates per mesh arrays to given capacity, mesh count is not changed
+ * 
+ * @param pData mesh data pointer
+ * @param capacity mesh capacity
+ */
+void __MDReserveMeshes(MeshData_t* pData, uint32_t capacity) {
+    if(capacity <= pData->mMeshCapacity) {
+        return;
+    }
+
+    pData->mMeshCapacity = capacity;
+
+    pData->mMeshes = MECRealloc(pData->mMeshes, sizeof(Mesh_t) * capacity);
+    pData->mMeshTransform = MECRealloc(pData->mMeshTransform, sizeof(Transform_t) * capacity);
+    pData->mMeshStart = MECRealloc(pData->mMeshStart, sizeof(uint32_t) * capacity);
+    pData->mIndexStart = MECRealloc(pData->mIndexStart, sizeof(uint32_t) * capacity);
+    pData->mMeshLod = MECRealloc(pData->mMeshLod, sizeof(uint32_t) * capacity);
+    pData->mMeshDirty = MECRealloc(pData->mMeshDirty, sizeof(bool) * capacity);
+    pData->mTransformDirty = MECRealloc(pData->mTransformDirty, sizeof(bool) * capacity);
+}
+
+void __MDReserveVertexIDs(MeshData_t* pData, size_t capacity) {
+    if(capacity <= pData->mVertexIDCapacity) {
+        return;
+    }
+
+    pData->mVertexIDCapacity = capacity;
+    pData->mTextureID = MECRealloc(pData->mTextureID, sizeof(float) * capacity);
+    pData->mMeshID = MECRealloc(pData->mMeshID, sizeof(float) * capacity);
+}
+
+/**
+ * @brief Grows texture and mesh IDs geometrically (like MAllocMesh), vertices [first, size) get no texture and given mesh
+ * 
+ * @param pData mesh data pointer
+ * @param mesh mesh index of new vertices
+ * @param first first new vertex
+ * @param size new vertex count
+ */
+void __MDGrowVertexIDs(MeshData_t* pData, uint32_t mesh, size_t first, size_t size) {
+    if(size > pData->mVertexIDCapacity) {
+        size_t capacity = pData->mVertexIDCapacity + pData->mVertexIDCapacity / 2;
+
+        __MDReserveVertexIDs(pData, capacity > size ? capacity : size);
+    }
+
+    for(size_t i = first; i < size; i++) {
+        pData->mTextureID[i] = 33.0f;
+        pData->mMeshID[i] = (float)mesh;
+    }
+}
+
+/**
+ * @brief Calculates joined vertex and index starts of meshes from given mesh on, starts of meshes before it are kept
+ * 
+ * @param pData mesh data pointer
+ * @param first first recalculated mesh
+ */
+void __MDCalculateMeshEnds(MeshData_t* pData, uint32_t first) {
+    for(uint32_t i = first; i < pData->mMeshCount; i++) {
+        pData->mMeshStart[i] = i == 0 ? 0 : pData->mMeshStart[i - 1] + pData->mMeshes[i - 1].mMeshSize;
+        pData->mIndexStart[i] = i == 0 ? 0 : pData->mIndexStart[i - 1] + __MDMeshIndexCount(&pData->mMeshes[i - 1]);
+    }
+}
+
+/**
+ * @brief Writes transformed vertex range (see MX4TransformPoints) and normals of mesh into allocated joined mesh and grows given bounds. With GPU transforms vertices are written in model space
+ * 
+ * @param pData mesh data pointer
+ * @param mesh mesh index (for transform)
+ * @param pSrc vertices to write
+ * @param srcFirst first source vertex
+ * @param count vertices amount
+ * @param first first joined vertex
+ * @param boundsMin bounds to grow
+ * @param boundsMax bounds to grow
+ */
+void __MDWriteVertexRange(MeshData_t* pData, uint32_t mesh, const Mesh_t* pSrc, size_t srcFirst, size_t count, size_t first, float* boundsMin, float* boundsMax) {
+    Mesh_t* joined = &pData->mJoinedMesh;
+    mat4_t identity = MX4Identity();
+    const mat4_t* transform = pData->mGPUTransforms ? &identity : &pData->mMeshTransform[mesh].mTransformMat;
+    float* vertices = &joined->mVertices[first * 3];
+    float bounds_min[3], bounds_max[3];
+
+    memcpy(bounds_min, boundsMin, sizeof(bounds_min));
+    memcpy(bounds_max, boundsMax, sizeof(bounds_max));
+
+    MX4TransformPoints(*transform, &pSrc->mVertices[srcFirst * 3], vertices, count);
+
+    for(size_t j = 0; j < count; j++) {
+        for(uint32_t c = 0; c < 3; c++) {
+            float value = vertices[j * 3 + c];
+
+            bounds_min[c] = value < bounds_min[c] ? value : bounds_min[c];
+            bounds_max[c] = value > bounds_max[c] ? value : bounds_max[c];
+        }
+    }
+
+    memcpy(boundsMin, bounds_min, sizeof(bounds_min));
+    memcpy(boundsMax, bounds_max, sizeof(bounds_max));
+
+    // normals follow inverse transpose, untouched when transform has no rotation or scale
+    bool linear_identity = true;
+
+    for(uint32_t r = 0; r < 3; r++) {
+        for(uint32_t c = 0; c < 3; c++) {
+            linear_identity = linear_identity && transform->m[r * 4 + c] == (r == c ? 1.0f : 0.0f);
+        }
+    }
+
+    if(linear_identity) {
+        memcpy(&joined->mNormals[first * 3], &pSrc->mNormals[srcFirst * 3], sizeof(float) * 3 * count);
+    }
+    else {
+        MX4TransformNormals(*transform, &pSrc->mNormals[srcFirst * 3], &joined->mNormals[first * 3], count);
+    }
+
+    memcpy(&joined->mColors[first * 4], &pSrc->mColors[srcFirst * 4], sizeof(float) * 4 * count);
+    memcpy(&joined->mTextureCoordinates[first * 2], &pSrc->mTextureCoordinates[srcFirst * 2], sizeof(float) * 2 * count);
+}
+
+/**
+ * @brief Writes transformed vertices of mesh into allocated joined mesh at given vertex and grows joined mesh bounds
+ * 
+ * @param pData mesh data pointer
+ * @param mesh mesh index (for transform)
+ * @param pSrc vertices to write
+ * @param first first joined vertex
+ */
+void __MDWriteVertices(MeshData_t* pData, uint32_t mesh, const Mesh_t* pSrc, size_t first) {
+    __MDWriteVertexRange(pData, mesh, pSrc, 0, pSrc->mMeshSize, first, pData->mJoinedMesh.mBoundsMin, pData->mJoinedMesh.mBoundsMax);
+}
+
+/**
+ * @brief Appends transformed vertices of mesh to joined mesh
+ * 
+ * @param pData mesh data pointer
+ * @param mesh mesh index (for transform)
+ * @param pSrc vertices to append
+ */
+void __MDJoinVertices(MeshData_t* pData, uint32_t mesh, const Mesh_t* pSrc) {
+    Mesh_t* joined = &pData->mJoinedMesh;
+    size_t first = joined->mMeshSize;
+
+    if(pSrc->mMeshSize == 0) {
+        return;
+    }
+
+    if(first == 0) {
+        for(uint32_t c = 0; c < 3; c++) {
+            joined->mBoundsMin[c] = FLT_MAX;
+            joined->mBoundsMax[c] = -FLT_MAX;
+        }
+    }
+
+    MAllocMesh(joined, first + pSrc->mMeshSize);
+    __MDWriteVertices(pData, mesh, pSrc, first);
+}
+
+/**
+ * @brief Appends mesh indices to joined mesh rebased onto mesh first joined vertex. When joined mesh becomes indexed meshes joined before get sequential indices
+ * 
+ * @param pData mesh data pointer
+ * @param mesh mesh index
+ * @param indices mesh local indices, nullptr for sequential ones
+ * @param count indices amount
+ */
+void __MDJoinIndices(MeshData_t* pData, uint32_t mesh, const uint32_t* indices, size_t count) {
+    Mesh_t* joined = &pData->mJoinedMesh;
+    uint32_t first = pData->mMeshStart[mesh];
+
+    if(joined->mIndexCount == 0) {
+        MAllocIndices(joined, first);
+
+        for(uint32_t j = 0; j < first; j++) {
+            joined->mIndices[j] = j;
+        }
+    }
+
+    size_t first_index = joined->mIndexCount;
+
+    MAllocIndices(joined, first_index + count);
+
+    for(size_t j = 0; j < count; j++) {
+        joined->mIndices[first_index + j] = first + (indices != nullptr ? indices[j] : (uint32_t)j);
+    }
+}
+
+/**
+ * @brief Appends transformed mesh to joined mesh
+ * 
+ * @param pData mesh data pointer
+ * @param mesh mesh index
+ */
+void __MDAppendMesh(MeshData_t* pData, uint32_t mesh) {
+    const Mesh_t* src = &pData->mMeshes[mesh];
+
+    __MDJoinVertices(pData, mesh, src);
+
+    if(src->mIndexCount != 0 || pData->mJoinedMesh.mIndexCount != 0) {
+        __MDJoinIndices(pData, mesh, src->mIndexCount != 0 ? src->mIndices : nullptr, __MDMeshIndexCount(src));
+    }
+}
+
+#define MD_JOIN_JOB_VERTICES 65536
+
+/**
+ * @brief Range of one mesh written by one job of MDRejoin, job writes vertices [mFirst, mFirst + mCount) or indices of same range
+ */
+typedef struct MDJoinRange_s {
+    uint32_t mMesh;
+    bool mIndices;
+    size_t mFirst;
+    size_t mCount;
+    float mBoundsMin[3];
+    float mBoundsMax[3];
+} MDJoinRange_t;
+
+typedef struct MDJoinJob_s {
+    MeshData_t* mData;
+    MDJoinRange_t* mRanges;
+} MDJoinJob_t;
+
+/**
+ * @brief Writes one range of MDRejoin into presized joined mesh, vertex ranges grow own bounds
+ *
+ * @param pArgs MDJoinJob_t pointer
+ * @param job range index
+ */
+void __MDJoinJob(void* pArgs, uint32_t job) {
+    MDJoinJob_t* join = (MDJoinJob_t*)pArgs;
+    MeshData_t* data = join->mData;
+    MDJoinRange_t* range = &join->mRanges[job];
+    const Mesh_t* src = &data->mMeshes[range->mMesh];
+
+    if(!range->mIndices) {
+        for(uint32_t c = 0; c < 3; c++) {
+            range->mBoundsMin[c] = FLT_MAX;
+            range->mBoundsMax[c] = -FLT_MAX;
+        }
+
+        size_t first = data->mMeshStart[range->mMesh] + range->mFirst;
+
+        __MDWriteVertexRange(data, range->mMesh, src, range->mFirst, range->mCount, first, range->mBoundsMin, range->mBoundsMax);
+
+        for(size_t j = 0; j < range->mCount; j++) {
+            data->mMeshID[first + j] = (float)range->mMesh;
+        }
+
+        return;
+    }
+
+    uint32_t* dst = &data->mJoinedMesh.mIndices[data->mIndexStart[range->mMesh] + range->mFirst];
+    uint32_t base = data->mMeshStart[range->mMesh];
+
+    for(size_t j = 0; j < range->mCount; j++) {
+        dst[j] = base + (src->mIndexCount != 0 ? src->mIndices[range->mFirst + j] : (uint32_t)(range->mFirst + j));
+    }
+}
+
+void __MDClearDirty(MeshData_t* pData) {
+    if(pData->mMeshDirty != nullptr) {
+        memset(pData->mMeshDirty, 0, sizeof(bool) * pData->mMeshCount);
+    }
+
+    pData->mDirtyCount = 0;
+}
+
+/**
+ * @brief Rebuild whole joined mesh from meshes and their transforms, dirty flags are cleared. Joined mesh is allocated once and meshes (large ones split into MD_JOIN_JOB_VERTICES ranges) are joined in parallel
+ * 
+ * @param pData mesh data pointer
+ */
+void MDRejoin(MeshData_t *pData) {
+    Mesh_t* joined = &pData->mJoinedMesh;
+    size_t vertex_count = 0, index_count = 0;
+    uint32_t range_count = 0;
+    bool indexed = false;
+
+    // joined buffers are kept, so rejoining same scene doesn`t allocate
+    joined->mMeshSize = 0;
+    joined->mIndexCount = 0;
+    joined->mLodCount = 0;
+    joined->mMeshletCount = 0;
+
+    __MDCalculateMeshEnds(pData, 0);
+    __MDClearDirty(pData);
+
+    for(uint32_t i = 0; i < pData->mMeshCount; i++) {
+        const Mesh_t* mesh = &pData->mMeshes[i];
+
+        vertex_count += mesh->mMeshSize;
+        index_count += __MDMeshIndexCount(mesh);
+        indexed = indexed || mesh->mIndexCount != 0;
+    }
+
+    // empty scene keeps no bounds or selected levels of previous join
+    if(vertex_count == 0) {
+        MCalculateBounds(joined);
+
+        if(pData->mMeshCount != 0) {
+            memset(pData->mMeshLod, 0, sizeof(uint32_t) * pData->mMeshCount);
+        }
+
+        return;
+    }
+
+    MAllocMesh(joined, vertex_count);
+    __MDReserveVertexIDs(pData, vertex_count);
+
+    if(indexed) {
+        MAllocIndices(joined, index_count);
+    }
+
+    for(uint32_t i = 0; i < pData->mMeshCount; i++) {
+        range_count += (uint32_t)((pData->mMeshes[i].mMeshSize + MD_JOIN_JOB_VERTICES - 1) / MD_JOIN_JOB_VERTICES);
+        range_count += indexed ? (uint32_t)((__MDMeshIndexCount(&pData->mMeshes[i]) + MD_JOIN_JOB_VERTICES - 1) / MD_JOIN_JOB_VERTICES) : 0;
+    }
+
+    MDJoinRange_t* ranges = (MDJoinRange_t*)MECCalloc(range_count, sizeof(MDJoinRange_t));
+    MDJoinJob_t join = { pData, ranges };
+    uint32_t range = 0;
+
+    for(uint32_t i = 0; i < pData->mMeshCount; i++) {
+        size_t vertices = pData->mMeshes[i].mMeshSize;
+        size_t indices = indexed ? __MDMeshIndexCount(&pData->mMeshes[i]) : 0;
+
+        for(size_t first = 0; first < vertices; first += MD_JOIN_JOB_VERTICES) {
+            ranges[range++] = (MDJoinRange_t){ i, false, first, vertices - first < MD_JOIN_JOB_VERTICES ? vertices - first : MD_JOIN_JOB_VERTICES, {0}, {0} };
+        }
+
+        for(size_t first = 0; first < indices; first += MD_JOIN_JOB_VERTICES) {
+            ranges[range++] = (MDJoinRange_t){ i, true, first, indices - first < MD_JOIN_JOB_VERTICES ? indices - first : MD_JOIN_JOB_VERTICES, {0}, {0} };
+        }
+    }
+
+    // small scenes don`t pay for handing jobs to pool
+    if(vertex_count < MD_JOIN_JOB_VERTICES) {
+        for(uint32_t r = 0; r < range_count; r++) {
+            __MDJoinJob(&join, r);
+        }
+    }
+    else {
+        MTParallelFor(range_count, __MDJoinJob, &join);
+    }
+
+    for(uint32_t c = 0; c < 3; c++) {
+        joined->mBoundsMin[c] = FLT_MAX;
+        joined->mBoundsMax[c] = -FLT_MAX;
+
+        for(uint32_t r = 0; r < range_count; r++) {
+            if(!ranges[r].mIndices) {
+                joined->mBoundsMin[c] = ranges[r].mBoundsMin[c] < joined->mBoundsMin[c] ? ranges[r].mBoundsMin[c] : joined->mBoundsMin[c];
+                joined->mBoundsMax[c] = ranges[r].mBoundsMax[c] > joined->mBoundsMax[c] ? ranges[r].mBoundsMax[c] : joined->mBoundsMax[c];
+            }
+        }
+    }
+
+    MECFree(ranges);
+}
+
+/**
+ * @brief Mark mesh as changed, its joined vertices are rewritten by next MDUpdate (or RDUpdateDirty). Call after editing vertices of mesh or its transform directly
+ * 
+ * @param pData mesh data pointer
+ * @param mesh mesh index
+ */
+void MDMarkDirty(MeshData_t* pData, uint32_t mesh) {
+    if(!pData->mMeshDirty[mesh]) {
+        pData->mMeshDirty[mesh] = true;
+        pData->mDirtyCount++;
+    }
+}
+
+/**
+ * @brief Mark transform of mesh as changed. With GPU transforms only its matrix is uploaded by next RDUpdateTransforms, otherwise mesh is marked dirty (see MDMarkDirty)
+ * 
+ * @param pData mesh data pointer
+ * @param mesh mesh index
+ */
+void MDMarkTransformDirty(MeshData_t* pData, uint32_t mesh) {
+    if(!pData->mGPUTransforms) {
+        MDMarkDirty(pData, mesh);
+    }
+    else if(!pData->mTransformDirty[mesh]) {
+        pData->mTransformDirty[mesh] = true;
+        pData->mTransformDirtyCount++;
+    }
+}
+
+void MDSetMeshPosition(MeshData_t* pData, uint32_t mesh, vec4_t position) {
+    TFSetPosition(&pData->mMeshTransform[mesh], position);
+    MDMarkTransformDirty(pData, mesh);
+}
+
+void MDSetMeshRotation(MeshData_t* pData, uint32_t mesh, vec4_t rotation) {
+    TFSetRotation(&pData->mMeshTransform[mesh], rotation);
+    MDMarkTransformDirty(pData, mesh);
+}
+
+void MDSetMeshScale(MeshData_t* pData, uint32_t mesh, vec4_t scale) {
+    TFSetScale(&pData->mMeshTransform[mesh], scale);
+    MDMarkTransformDirty(pData, mesh);
+}
+
+/**
+ * @brief Switch between joined mesh baked with mesh transforms and joined mesh in model space whose meshes are transformed by vertex shader from storage buffer of matrices (looked up by per vertex mesh ID, shader location 5). Moving mesh then uploads only its matrix. Joined mesh is rejoined, render data using it has to be updated (RDUpdateMesh)
+ * 
+ * @param pData mesh data pointer
+ * @param gpuTransforms apply mesh transforms on GPU
+ */
+void MDSetGPUTransforms(MeshData_t* pData, bool gpuTransforms) {
+    if(pData->mGPUTransforms == gpuTransforms) {
+        return;
+    }
+
+    pData->mGPUTransforms = gpuTransforms;
+    pData->mTransformDirtyCount = 0;
+
+    if(pData->mTransformDirty != nullptr) {
+        memset(pData->mTransformDirty, 0, sizeof(bool) * pData->mMeshCount);
+    }
+
+    MDRejoin(pData);
+}
+
+/**
+ * @brief Rewrites joined vertices of dirty meshes in their places (mMeshStart), joined bounds only grow. When vertex count of dirty mesh changed whole joined mesh is rejoined. Dirty flags are kept unless mesh data was rejoined
+ * 
+ * @param pData mesh data pointer
+ * @return true when only vertices of dirty meshes changed
+ */
+bool __MDRewriteDirty(MeshData_t* pData) {
+    for(uint32_t i = 0; i < pData->mMeshCount; i++) {
+        size_t end = i + 1 < pData->mMeshCount ? pData->mMeshStart[i + 1] : pData->mJoinedMesh.mMeshSize;
+
+        if(pData->mMeshDirty[i] && pData->mMeshes[i].mMeshSize != end - pData->mMeshStart[i]) {
+            MDRejoin(pData);
+
+            return false;
+        }
+    }
+
+    for(uint32_t i = 0; i < pData->mMeshCount; i++) {
+        if(pData->mMeshDirty[i]) {
+            __MDWriteVertices(pData, i, &pData->mMeshes[i], pData->mMeshStart[i]);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Rewrite joined vertices of meshes marked dirty (see MDMarkDirty) instead of rejoining all meshes. Vertex count changes fall back to MDRejoin, index changes need MDRejoin
+ * 
+ * @param pData mesh data pointer
+ */
+void MDUpdate(MeshData_t* pData) {
+    if(pData->mDirtyCount == 0) {
+        return;
+    }
+
+    if(__MDRewriteDirty(pData)) {
+        __MDClearDirty(pData);
+    }
+}
+
+/**
+ * @brief Reserve memory for meshCount meshes and vertexCount joined vertices, so scene of known size is assembled without reallocations. Mesh count is not changed
+ * 
+ * @param pData mesh data pointer
+ * @param meshCount mesh capacity
+ * @param vertexCount joined vertex capacity
+ */
+void MDReserve(MeshData_t* pData, uint32_t meshCount, size_t vertexCount) {
+    __MDReserveMeshes(pData, meshCount);
+    __MDReserveVertexIDs(pData, vertexCount);
+    MReserveMesh(&pData->mJoinedMesh, vertexCount);
+}
+
+/**
+ * @brief Add meshes (owned by mesh data afterwards) with identity transforms and append them to joined mesh. Mesh arrays grow geometrically and only starts of added meshes are calculated, so adding meshes one by one is amortized linear too
+ * 
+ * @param pData mesh data pointer
+ * @param meshes meshes to add
+ * @param count meshes amount
+ */
+void MDAddMeshes(MeshData_t* pData, const Mesh_t* meshes, uint32_t count) {
+    uint32_t first = pData->mMeshCount;
+
+    if(count == 0) {
+        return;
+    }
+
+    if(first + count > pData->mMeshCapacity) {
+        uint32_t capacity = pData->mMeshCapacity + pData->mMeshCapacity / 2;
+
+        __MDReserveMeshes(pData, capacity > first + count ? capacity : first + count);
+    }
+
+    memcpy(&pData->mMeshes[first], meshes, sizeof(Mesh_t) * count);
+    memset(&pData->mMeshTransform[first], 0, sizeof(Transform_t) * count);
+    memset(&pData->mMeshLod[first], 0, sizeof(uint32_t) * count);
+    memset(&pData->mMeshDirty[first], 0, sizeof(bool) * count);
+    memset(&pData->mTransformDirty[first], 0, sizeof(bool) * count);
+
+    for(uint32_t i = 0; i < count; i++) {
+        TFSetScale(&pData->mMeshTransform[first + i], (vec4_t){1.0, 1.0, 1.0, 1.0});
+    }
+
+    pData->mMeshCount += count;
+
+    __MDCalculateMeshEnds(pData, first);
+
+    for(uint32_t i = first; i < pData->mMeshCount; i++) {
+        __MDGrowVertexIDs(pData, i, pData->mMeshStart[i], pData->mMeshStart[i] + pData->mMeshes[i].mMeshSize);
+        __MDAppendMesh(pData, i);
+    }
+}
+
+void MDAddMesh(MeshData_t* pData, Mesh_t mesh) {
+    MDAddMeshes(pData, &mesh, 1);
+}
+
+/**
+ * @brief Append streamed batch (see MStreamPLYMeshFromFile) to last mesh of mesh data and to joined mesh. Last mesh has to be empty when streaming starts, e.g. added with MDAddMesh right before
+ * 
+ * @param pData mesh data pointer
+ * @param pBatch vertex or index batch
+ */
+void MDAppendBatch(MeshData_t* pData, const MeshBatch_t* pBatch) {
+    uint32_t last = pData->mMeshCount - 1;
+    Mesh_t* mesh = &pData->mMeshes[last];
+
+    if(pBatch->mVertices != nullptr) {
+        const Mesh_t* src = pBatch->mVertices;
+        size_t first = mesh->mMeshSize;
+        size_t joined_first = pData->mJoinedMesh.mMeshSize;
+
+        MAllocMesh(mesh, first + src->mMeshSize);
+
+        memcpy(&mesh->mVertices[first * 3], src->mVertices, sizeof(float) * 3 * src->mMeshSize);
+        memcpy(&mesh->mNormals[first * 3], src->mNormals, sizeof(float) * 3 * src->mMeshSize);
+        memcpy(&mesh->mColors[first * 4], src->mColors, sizeof(float) * 4 * src->mMeshSize);
+        memcpy(&mesh->mTextureCoordinates[first * 2], src->mTextureCoordinates, sizeof(float) * 2 * src->mMeshSize);
+
+        __MDGrowVertexIDs(pData, last, joined_first, joined_first + src->mMeshSize);
+
+        __MDJoinVertices(pData, last, src);
+    }
+
+    if(pBatch->mIndexCount != 0) {
+        size_t first = mesh->mIndexCount;
+
+        MAllocIndices(mesh, first + pBatch->mIndexCount);
+        memcpy(&mesh->mIndices[first], pBatch->mIndices, sizeof(uint32_t) * pBatch->mIndexCount);
+
+        __MDJoinIndices(pData, last, pBatch->mIndices, pBatch->mIndexCount);
+    }
+}
+
+// finer LOD level is picked again only when its error is below threshold * MD_LOD_HYSTERESIS, so LOD doesn`t flicker on boundary
+#define MD_LOD_HYSTERESIS 0.75f
+
+/**
+ * @brief Projected size of object space error in pixels
+ * 
+ * @param error object space error
+ * @param distance distance from camera
+ * @param projectionScale viewport height / (2 * tan(fov / 2))
+ * @return float 
+ */
+float __MDLodScreenError(float error, float distance, float projectionScale) {
+    return distance > 0.0f ? error * projectionScale / distance : (error > 0.0f ? FLT_MAX : 0.0f);
+}
+
+/**
+ * @brief Largest absolute scale of transform, bounding spheres scaled by it stay conservative
+ * 
+ * @param pTransform transform pointer
+ * @return float 
+ */
+float __MDTransformScale(const Transform_t* pTransform) {
+    float x = fabsf((float)pTransform->mScale.x), y = fabsf((float)pTransform->mScale.y), z = fabsf((float)pTransform->mScale.z);
+
+    return x > y ? (x > z ? x : z) : (y > z ? y : z);
+}
+
+/**
+ * @brief Pick LOD level of every submesh (see MOGenerateLods) from projected screen space error: coarsest level whose error stays under threshold. Coarser level is taken only when its error is under MD_LOD_HYSTERESIS of threshold, so submeshes at switching distance don`t flicker between levels
+ * 
+ * @param pData mesh data pointer
+ * @param camera camera position in joined mesh space
+ * @param projectionScale viewport height / (2 * tan(fov / 2))
+ * @param threshold largest allowed error in pixels
+ * @return true when any submesh changed level
+ */
+bool MDSelectLods(MeshData_t* pData, vec4_t camera, float projectionScale, float threshold) {
+    bool changed = false;
+
+    for(uint32_t i = 0; i < pData->mMeshCount; i++) {
+        const Mesh_t* mesh = &pData->mMeshes[i];
+        const Transform_t* transform = &pData->mMeshTransform[i];
+        uint32_t level = pData->mMeshLod[i] < mesh->mLodCount ? pData->mMeshLod[i] : 0;
+
+        if(mesh->mLodCount < 2) {
+            changed |= pData->mMeshLod[i] != 0;
+            pData->mMeshLod[i] = 0;
+
+            continue;
+        }
+
+        float extent[3], scale = __MDTransformScale(transform);
+
+        for(uint32_t c = 0; c < 3; c++) {
+            extent[c] = (mesh->mBoundsMax[c] - mesh->mBoundsMin[c]) * 0.5f;
+        }
+
+        vec4_t center = MX4MulV(transform->mTransformMat, (vec4_t){(mesh->mBoundsMin[0] + mesh->mBoundsMax[0]) * 0.5f, (mesh->mBoundsMin[1] + mesh->mBoundsMax[1]) * 0.5f, (mesh->mBoundsMin[2] + mesh->mBoundsMax[2]) * 0.5f, 1.0});
+        float offset[3] = { (float)(center.x - camera.x), (float)(center.y - camera.y), (float)(center.z - camera.z) };
+        float radius = sqrtf(extent[0] * extent[0] + extent[1] * extent[1] + extent[2] * extent[2]) * scale;
+        float distance = sqrtf(offset[0] * offset[0] + offset[1] * offset[1] + offset[2] * offset[2]) - radius;
+
+        while(level > 0 && __MDLodScreenError(mesh->mLods[level].mError * scale, distance, projectionScale) > threshold) {
+            level--;
+        }
+
+        while(level + 1 < mesh->mLodCount && __MDLodScreenError(mesh->mLods[level + 1].mError * scale, distance, projectionScale) <= threshold * MD_LOD_HYSTERESIS) {
+            level++;
+        }
+
+        changed |= pData->mMeshLod[i] != level;
+        pData->mMeshLod[i] = level;
+    }
+
+    return changed;
+}
+
+/**
+ * @brief Vertex attribute read straight from source buffer of render data (e.g. accessor of .glb BIN chunk), type 0 means attribute is missing and its constant default is used
+ */
+typedef struct RDSourceAttribute_s {
+    size_t mOffset;
+    uint32_t mStride;
+    uint32_t mType;
+    uint32_t mDimmensions;
+    bool mNormalized;
+} RDSourceAttribute_t;
+
+/**
+ * @brief One draw from source buffer, attributes are in shader location order (position, color, normal, texture coordinates). Index type 0 means draw is not indexed
+ */
+typedef struct RDSourceDraw_s {
+    RDSourceAttribute_t mAttributes[4];
+    size_t mIndexOffset;
+    uint32_t mIndexType;
+    uint32_t mCount;
+    uint32_t mMode;
+} RDSourceDraw_t;
+
+typedef struct RenderData_s {
+    MeshData_t* mMeshPtr;
+
+    VArray_t mVArray;
+    VertexFormat_t mFormat;
+    VBuffer_t mStreams[VF_MAX_STREAMS];
+    IBuffer_t mIndexBuffer;
+    VBuffer_t mSourceBuffer;
+    SBuffer_t mTransformBuffer;
+    TextureArray_t *mTexturesPtr[32];
+
+    RDSourceDraw_t* mSourceDraws;
+    uint32_t mSourceDrawCount;
+
+    // LOD levels of submeshes are uploaded after index capacity, each submesh is then drawn at its selected level (meshlet culled ranges for full detail)
+    uint32_t* mLodIndexStart;
+    int32_t* mDrawCounts;
+    const void** mDrawOffsets;
+    uint32_t mDrawCount;
+    uint32_t mDrawCapacity;
+    bool mMultiDraw;
+    uint32_t mLodMeshCount;
+    uint32_t mLodIndexCount;
+
+    // positions of format are quantized inside bounds
+    bool mCompact;
+    float mBoundsMin[3];
+    float mBoundsMax[3];
+
+    uint32_t mVertexCount;
+    uint32_t mIndexCount;
+    uint32_t mIndexType;
+    uint32_t mVertexCapacity;
+    uint32_t mIndexCapacity;
+    uint32_t mTransformCount;
+} RenderData_t;
+
+// constant values of shader locations missing in vertex format (position, color, normal, texture coordinates, texture ID, mesh ID)
+const float gRDAttributeDefaults[VF_MAX_ATTRIBUTES][4] = { {0.0f, 0.0f, 0.0f, 1.0f}, {1.0f, 1.0f, 1.0f, 1.0f}, {0.0f, 0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 0.0f, 1.0f}, {33.0f, 0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 0.0f, 1.0f} };
+
+/**
+ * @brief Separate float streams format, one vertex buffer per attribute (default format of render data)
+ * 
+ * @return VertexFormat_t 
+ */
+VertexFormat_t RDSeparateFormat() {
+    VertexFormat_t format;
+    VFInitialize(&format);
+
+    VFAddAttribute(&format, 0, 0, GL_FLOAT, 3, false);
+    VFAddAttribute(&format, 1, 1, GL_FLOAT, 4, false);
+    VFAddAttribute(&format, 2, 2, GL_FLOAT, 3, false);
+    VFAddAttribute(&format, 3, 3, GL_FLOAT, 2, false);
+    VFAddAttribute(&format, 4, 4, GL_FLOAT, 1, false);
+
+    return format;
+}
+
+/**
+ * @brief Interleaved float format, all attributes in one 52 byte vertex
+ * 
+ * @return VertexFormat_t 
+ */
+VertexFormat_t RDInterleavedFormat() {
+    VertexFormat_t format;
+    VFInitialize(&format);
+
+    VFAddAttribute(&format, 0, 0, GL_FLOAT, 3, false);
+    VFAddAttribute(&format, 1, 0, GL_FLOAT, 4, false);
+    VFAddAttribute(&format, 2, 0, GL_FLOAT, 3, false);
+    VFAddAttribute(&format, 3, 0, GL_FLOAT, 2, false);
+    VFAddAttribute(&format, 4, 0, GL_FLOAT, 1, false);
+
+    return format;
+}
+
+/**
+ * @brief Compact format, 16 byte quantized vertex with CompactVertex_t layout in stream 0 and float texture IDs in stream 1
+ * 
+ * @return VertexFormat_t 
+ */
+VertexFormat_t RDCompactFormat() {
+    VertexFormat_t format;
+    VFInitialize(&format);
+
+    VFAddAttribute(&format, 0, 0, GL_UNSIGNED_SHORT, 3, true);
+    VFAddAttribute(&format, 2, 0, GL_BYTE, 2, true);
+    VFAddAttribute(&format, 3, 0, GL_HALF_FLOAT, 2, false);
+    VFAddAttribute(&format, 1, 0, GL_UNSIGNED_BYTE, 4, true);
+    VFAddAttribute(&format, 4, 1, GL_FLOAT, 1, false);
+
+    return format;
+}
+
+/**
+ * @brief Gives constant default value to shader location of bound vertex array
+ * 
+ * @param location shader location
+ */
+void __RDSetAttributeDefault(uint32_t location) {
+    glDisableVertexAttribArray(location);
+    glVertexAttrib4fv(location, gRDAttributeDefaults[location]);
+}
+
+/**
+ * @brief Uploads indices rebased by base vertex at given place in element buffer, converting them to 16 bit when render data uses short indices
+ * 
+ * @param pRd render data pointer
+ * @param first first element in element buffer
+ * @param indices source indices
+ * @param count indices amount
+ * @param base added to every index
+ */
+void __RDUploadIndexRange(RenderData_t* pRd, size_t first, const uint32_t* indices, size_t count, uint32_t base) {
+    if(count == 0) {
+        return;
+    }
+
+    if(pRd->mIndexType == GL_UNSIGNED_INT && base == 0) {
+        IBBindSubData(&pRd->mIndexBuffer, sizeof(uint32_t) * first, indices, sizeof(uint32_t) * count);
+
+        return;
+    }
+
+    size_t index_size = pRd->mIndexType == GL_UNSIGNED_INT ? sizeof(uint32_t) : sizeof(uint16_t);
+    void* converted = MECMalloc(index_size * count);
+
+    for(size_t i = 0; i < count; i++) {
+        if(pRd->mIndexType == GL_UNSIGNED_INT) {
+            ((uint32_t*)converted)[i] = indices[i] + base;
+        }
+        else {
+            ((uint16_t*)converted)[i] = (uint16_t)(indices[i] + base);
+        }
+    }
+
+    IBBindSubData(&pRd->mIndexBuffer, index_size * first, converted, index_size * count);
+
+    MECFree(converted);
+}
+
+/**
+ * @brief Uploads indices [first, first + count) of joined mesh at their place in element buffer
+ * 
+ * @param pRd render data pointer
+ * @param first first index
+ * @param count indices amount
+ */
+void __RDUploadIndices(RenderData_t* pRd, size_t first, size_t count) {
+    __RDUploadIndexRange(pRd, first, &pRd->mMeshPtr->mJoinedMesh.mIndices[first], count, 0);
+}
+
+/**
+ * @brief Amount of LOD level indices (levels after full mesh) of all submeshes
+ * 
+ * @param pData mesh data pointer
+ * @return size_t 
+ */
+size_t __RDLodIndexCount(const MeshData_t* pData) {
+    size_t count = 0;
+
+    for(uint32_t i = 0; i < pData->mMeshCount; i++) {
+        count += MLodIndexEnd(&pData->mMeshes[i]) - pData->mMeshes[i].mIndexCount;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Appends index range of element buffer to draw list, range continuing last draw extends it
+ * 
+ * @param pRd render data pointer
+ * @param first first element
+ * @param count elements amount
+ */
+void __RDPushDraw(RenderData_t* pRd, size_t first, size_t count) {
+    size_t index_size = pRd->mIndexType == GL_UNSIGNED_INT ? sizeof(uint32_t) : sizeof(uint16_t);
+    uint32_t last = pRd->mDrawCount - 1;
+
+    if(count == 0) {
+        return;
+    }
+
+    if(pRd->mDrawCount != 0 && (size_t)pRd->mDrawOffsets[last] + (size_t)pRd->mDrawCounts[last] * index_size == first * index_size) {
+        pRd->mDrawCounts[last] += (int32_t)count;
+
+        return;
+    }
+
+    if(pRd->mDrawCount == pRd->mDrawCapacity) {
+        pRd->mDrawCapacity = pRd->mDrawCapacity == 0 ? 16 : pRd->mDrawCapacity * 2;
+        pRd->mDrawCounts = MECRealloc(pRd->mDrawCounts, sizeof(int32_t) * pRd->mDrawCapacity);
+        pRd->mDrawOffsets = MECRealloc(pRd->mDrawOffsets, sizeof(const void*) * pRd->mDrawCapacity);
+    }
+
+    pRd->mDrawCounts[pRd->mDrawCount] = (int32_t)count;
+    pRd->mDrawOffsets[pRd->mDrawCount] = (const void*)(first * index_size);
+    pRd->mDrawCount++;
+}
+
+/**
+ * @brief Whether meshlet transformed into joined mesh space can be visible: its sphere is not outside of any frustum plane and its normal cone doesn`t face away from camera
+ * 
+ * @param pMeshlet meshlet in submesh space
+ * @param pTransform submesh transform
+ * @param scale largest submesh scale
+ * @param cone test normal cone (transform scale is uniform)
+ * @param planes frustum planes (see MX4FrustumPlanes)
+ * @param camera camera position in joined mesh space
+ * @return true when meshlet has to be drawn
+ */
+bool __RDMeshletVisible(const Meshlet_t* pMeshlet, const Transform_t* pTransform, float scale, bool cone, const vec4_t* planes, vec4_t camera) {
+    vec4_t center = MX4MulV(pTransform->mTransformMat, (vec4_t){pMeshlet->mCenter[0], pMeshlet->mCenter[1], pMeshlet->mCenter[2], 1.0});
+    float radius = pMeshlet->mRadius * scale;
+
+    for(uint32_t p = 0; p < 6; p++) {
+        if(planes[p].x * center.x + planes[p].y * center.y + planes[p].z * center.z + planes[p].w < -radius) {
+            return false;
+        }
+    }
+
+    if(!cone || pMeshlet->mConeCutoff >= 1.0f) {
+        return true;
+    }
+
+    vec4_t axis = MX4ToDirection(pTransform->mTransformMat, (vec4_t){pMeshlet->mConeAxis[0], pMeshlet->mConeAxis[1], pMeshlet->mConeAxis[2], 0.0});
+    vec4_t view = (vec4_t){center.x - camera.x, center.y - camera.y, center.z - camera.z, 0.0};
+    float view_length = sqrtf((float)(view.x * view.x + view.y * view.y + view.z * view.z));
+    float axis_dot = (float)(view.x * axis.x + view.y * axis.y + view.z * axis.z) / scale;
+
+    return axis_dot < pMeshlet->mConeCutoff * view_length + radius;
+}
+
+/**
+ * @brief Rebuilds draw list of bound mesh data at selected LOD levels. With frustum planes, submeshes and meshlets of full detail submeshes are culled
+ * 
+ * @param pRd render data pointer
+ * @param planes frustum planes or nullptr to draw everything
+ * @param camera camera position in joined mesh space
+ */
+void __RDBuildDraws(RenderData_t* pRd, const vec4_t* planes, vec4_t camera) {
+    const MeshData_t* data = pRd->mMeshPtr;
+
+    pRd->mDrawCount = 0;
+
+    for(uint32_t i = 0; i < data->mMeshCount; i++) {
+        const Mesh_t* mesh = &data->mMeshes[i];
+        const Transform_t* transform = &data->mMeshTransform[i];
+        uint32_t level = i < pRd->mLodMeshCount && data->mMeshLod[i] < mesh->mLodCount ? data->mMeshLod[i] : 0;
+        float scale = __MDTransformScale(transform);
+
+        if(planes != nullptr) {
+            Meshlet_t bounds;
+            memset(&bounds, 0, sizeof(Meshlet_t));
+
+            for(uint32_t c = 0; c < 3; c++) {
+                float extent = (mesh->mBoundsMax[c] - mesh->mBoundsMin[c]) * 0.5f;
+
+                bounds.mCenter[c] = mesh->mBoundsMin[c] + extent;
+                bounds.mRadius += extent * extent;
+            }
+
+            bounds.mRadius = sqrtf(bounds.mRadius);
+
+            if(!__RDMeshletVisible(&bounds, transform, scale, false, planes, camera)) {
+                continue;
+            }
+        }
+
+        if(level != 0) {
+            __RDPushDraw(pRd, pRd->mLodIndexStart[i] + mesh->mLods[level].mIndexOffset - mesh->mIndexCount, mesh->mLods[level].mIndexCount);
+
+            continue;
+        }
+
+        if(planes == nullptr || mesh->mMeshletCount == 0 || mesh->mIndexCount == 0) {
+            __RDPushDraw(pRd, data->mIndexStart[i], __MDMeshIndexCount(mesh));
+
+            continue;
+        }
+
+        bool uniform = fabsf((float)transform->mScale.x) == fabsf((float)transform->mScale.y) && fabsf((float)transform->mScale.y) == fabsf((float)transform->mScale.z);
+
+        for(uint32_t m = 0; m < mesh->mMeshletCount; m++) {
+            const Meshlet_t* meshlet = &mesh->mMeshlets[m];
+
+            if(__RDMeshletVisible(meshlet, transform, scale, uniform, planes, camera)) {
+                __RDPushDraw(pRd, data->mIndexStart[i] + meshlet->mIndexOffset, meshlet->mIndexCount);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Rebuild per submesh draws from LOD levels selected in bound mesh data (see MDSelectLods), call after selection changed. Render data without LOD levels is drawn in one draw call. Culled draw list (see RDCullMeshlets) is replaced
+ * 
+ * @param pRd render data pointer
+ */
+void RDUpdateLods(RenderData_t* pRd) {
+    pRd->mMultiDraw = pRd->mLodIndexCount != 0 && pRd->mMeshPtr->mJoinedMesh.mIndexCount != 0;
+
+    if(pRd->mMultiDraw) {
+        __RDBuildDraws(pRd, nullptr, (vec4_t){0.0, 0.0, 0.0, 1.0});
+    }
+}
+
+/**
+ * @brief Cull submeshes and meshlets (see MOBuildMeshlets) of bound mesh data against view frustum and cull back facing meshlets by their normal cones, visible ranges are drawn by RRender at selected LOD levels. Call every frame after RDSelectLods, joined mesh has to be indexed
+ * 
+ * @param pRd render data pointer
+ * @param viewProjection view projection matrix in joined mesh space (MX4MulV convention)
+ * @param camera camera position in joined mesh space
+ */
+void RDCullMeshlets(RenderData_t* pRd, mat4_t viewProjection, vec4_t camera) {
+    vec4_t planes[6];
+
+    if(pRd->mMeshPtr->mJoinedMesh.mIndexCount == 0) {
+        return;
+    }
+
+    MX4FrustumPlanes(viewProjection, planes);
+    __RDBuildDraws(pRd, planes, camera);
+
+    pRd->mMultiDraw = true;
+}
+
+/**
+ * @brief Uploads vertices [first, first + count) of joined mesh at their place in vertex buffers
+ * 
+ * @param pRd render data pointer
+ * @param first first vertex
+ * @param count vertices amount
+ */
+void __RDUploadVertices(RenderData_t* pRd, size_t first, size_t count) {
+    const Mesh_t* joined = &pRd->mMeshPtr->mJoinedMesh;
+
+    if(count == 0) {
+        return;
+    }
+
+    const float* texture_ids = pRd->mMeshPtr->mTextureID;
+    const float* mesh_ids = pRd->mMeshPtr->mMeshID;
+    const VertexFormat_t* format = &pRd->mFormat;
+    void* encoded = nullptr;
+
+    for(uint32_t stream = 0; stream < format->mStreamCount; stream++) {
+        uint32_t stride = format->mStrides[stream];
+        const void* source = nullptr;
+
+        if(stride == 0) {
+            continue;
+        }
+
+        // stream holding only float attribute in mesh layout is uploaded without encoding
+        for(uint32_t i = 0; i < VF_MAX_ATTRIBUTES; i++) {
+            const VertexAttribute_t* attribute = &format->mAttributes[i];
+            uint32_t dimmensions = 0;
+            const float* values = __MVertexStream(joined, texture_ids, mesh_ids, i, &dimmensions);
+
+            if(attribute->mDimmensions != 0 && attribute->mStream == stream && attribute->mType == GL_FLOAT && attribute->mDimmensions == dimmensions && stride == sizeof(float) * dimmensions) {
+                source = &values[first * dimmensions];
+            }
+        }
+
+        if(source == nullptr) {
+            encoded = MECRealloc(encoded, (size_t)stride * count);
+            MEncodeVertexStream(joined, texture_ids, mesh_ids, format, stream, pRd->mBoundsMin, pRd->mBoundsMax, first, count, encoded);
+
+            source = encoded;
+        }
+
+        VBBindSubData(&pRd->mStreams[stream], (size_t)stride * first, source, (size_t)stride * count);
+    }
+
+    if(encoded != nullptr) {
+        MECFree(encoded);
+    }
+}
+
+/**
+ * @brief Uploads transform matrices of all meshes of bound mesh data to storage buffer, transform dirty flags are cleared
+ * 
+ * @param pRd render data pointer
+ */
+void __RDUploadTransforms(RenderData_t* pRd) {
+    MeshData_t* data = pRd->mMeshPtr;
+    mat4_t* matrices = (mat4_t*)MECMalloc(sizeof(mat4_t) * (data->mMeshCount != 0 ? data->mMeshCount : 1));
+
+    for(uint32_t i = 0; i < data->mMeshCount; i++) {
+        matrices[i] = data->mMeshTransform[i].mTransformMat;
+    }
+
+    SBBindData(&pRd->mTransformBuffer, matrices, sizeof(mat4_t) * (data->mMeshCount != 0 ? data->mMeshCount : 1));
+
+    MECFree(matrices);
+
+    if(data->mTransformDirty != nullptr) {
+        memset(data->mTransformDirty, 0, sizeof(bool) * data->mMeshCount);
+    }
+
+    data->mTransformDirtyCount = 0;
+    pRd->mTransformCount = data->mMeshCount;
+}
+
+/**
+ * @brief Recreates GPU buffers with given capacities and uploads first vertices and indices of joined mesh (LOD levels are uploaded whole). 16 bit indices are used when vertex capacity fits them
+ * 
+ * @param pRd render data pointer
+ * @param vertexCapacity vertex buffers capacity
+ * @param indexCapacity element buffer capacity
+ * @param vertexCount amount of uploaded vertices
+ * @param indexCount amount of uploaded indices
+ */
+void __RDUploadMesh(RenderData_t* pRd, size_t vertexCapacity, size_t indexCapacity, size_t vertexCount, size_t indexCount) {
+    const Mesh_t* joined = &pRd->mMeshPtr->mJoinedMesh;
+
+    if(pRd->mFormat.mStreamCount == 0) {
+        pRd->mFormat = RDSeparateFormat();
+    }
+
+    // mesh IDs select matrix of GPU transforms, they get own stream when format has none
+    if(pRd->mMeshPtr->mGPUTransforms && pRd->mFormat.mAttributes[5].mDimmensions == 0) {
+        VFAddAttribute(&pRd->mFormat, 5, pRd->mFormat.mStreamCount, GL_FLOAT, 1, false);
+    }
+
+    VABind(&pRd->mVArray);
+
+    memcpy(pRd->mBoundsMin, joined->mBoundsMin, sizeof(pRd->mBoundsMin));
+    memcpy(pRd->mBoundsMax, joined->mBoundsMax, sizeof(pRd->mBoundsMax));
+
+    VASetFormat(&pRd->mVArray, &pRd->mFormat);
+
+    for(uint32_t stream = 0; stream < pRd->mFormat.mStreamCount; stream++) {
+        uint32_t stride = pRd->mFormat.mStrides[stream];
+
+        if(stride != 0) {
+            VBBindData(&pRd->mStreams[stream], nullptr, (uint32_t)(stride * vertexCapacity));
+            VABindStream(&pRd->mVArray, stream, &pRd->mStreams[stream], stride);
+        }
+    }
+
+    pRd->mIndexType = vertexCapacity <= (size_t)UINT16_MAX + 1 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+    pRd->mLodIndexCount = joined->mIndexCount != 0 ? (uint32_t)__RDLodIndexCount(pRd->mMeshPtr) : 0;
+
+    if(indexCapacity != 0) {
+        IBBindData(&pRd->mIndexBuffer, nullptr, (pRd->mIndexType == GL_UNSIGNED_SHORT ? sizeof(uint16_t) : sizeof(uint32_t)) * (indexCapacity + pRd->mLodIndexCount));
+    }
+
+    __RDUploadVertices(pRd, 0, vertexCount);
+    __RDUploadIndices(pRd, 0, indexCount);
+
+    if(pRd->mLodIndexCount != 0) {
+        const MeshData_t* data = pRd->mMeshPtr;
+        size_t first = indexCapacity;
+
+        pRd->mLodIndexStart = MECRealloc(pRd->mLodIndexStart, sizeof(uint32_t) * data->mMeshCount);
+
+        for(uint32_t i = 0; i < data->mMeshCount; i++) {
+            const Mesh_t* mesh = &data->mMeshes[i];
+            size_t count = MLodIndexEnd(mesh) - mesh->mIndexCount;
+
+            __RDUploadIndexRange(pRd, first, &mesh->mIndices[mesh->mIndexCount], count, data->mMeshStart[i]);
+
+            pRd->mLodIndexStart[i] = (uint32_t)first;
+            first += count;
+        }
+    }
+
+    VAUnbind();
+
+    pRd->mVertexCount = (uint32_t)vertexCount;
+    pRd->mIndexCount = (uint32_t)indexCount;
+    pRd->mVertexCapacity = (uint32_t)vertexCapacity;
+    pRd->mIndexCapacity = (uint32_t)indexCapacity;
+    pRd->mLodMeshCount = pRd->mMeshPtr->mMeshCount;
+
+    if(pRd->mMeshPtr->mGPUTransforms) {
+        __RDUploadTransforms(pRd);
+    }
+
+    // submesh draws would reach past uploaded part
+    if(vertexCount == joined->mMeshSize && indexCount == joined->mIndexCount) {
+        RDUpdateLods(pRd);
+    }
+    else {
+        pRd->mMultiDraw = false;
+    }
+}
+
+/**
+ * @brief Upload joined mesh to GPU. Indexed joined mesh uploads element buffer too, 16 bit indices are used when vertex count fits them
+ * 
+ * @param pRd render data pointer
+ */
+void RDUpdateMesh(RenderData_t* pRd) {
+    const Mesh_t* joined = &pRd->mMeshPtr->mJoinedMesh;
+
+    __RDUploadMesh(pRd, joined->mMeshSize, joined->mIndexCount, joined->mMeshSize, joined->mIndexCount);
+}
+
+/**
+ * @brief Upload only vertices and indices appended to joined mesh since last upload (e.g. by MDAppendBatch). Buffers grow geometrically, so streamed mesh is reuploaded whole only a few times (compact render data is reuploaded also when joined mesh bounds grow)
+ * 
+ * @param pRd render data pointer
+ */
+void RDAppendMesh(RenderData_t* pRd) {
+    const Mesh_t* joined = &pRd->mMeshPtr->mJoinedMesh;
+
+    bool bounds_changed = pRd->mCompact && (memcmp(pRd->mBoundsMin, joined->mBoundsMin, sizeof(pRd->mBoundsMin)) != 0 || memcmp(pRd->mBoundsMax, joined->mBoundsMax, sizeof(pRd->mBoundsMax)) != 0);
+
+    bool lods_changed = pRd->mLodIndexCount != (joined->mIndexCount != 0 ? __RDLodIndexCount(pRd->mMeshPtr) : 0);
+
+    if(joined->mMeshSize < pRd->mVertexCount || joined->mIndexCount < pRd->mIndexCount || bounds_changed || lods_changed) {
+        RDUpdateMesh(pRd);
+
+        return;
+    }
+
+    if(joined->mMeshSize > pRd->mVertexCapacity || joined->mIndexCount > pRd->mIndexCapacity) {
+        size_t vertex_capacity = (size_t)pRd->mVertexCapacity + pRd->mVertexCapacity / 2;
+        size_t index_capacity = (size_t)pRd->mIndexCapacity + pRd->mIndexCapacity / 2;
+
+        vertex_capacity = vertex_capacity > joined->mMeshSize ? vertex_capacity : joined->mMeshSize;
+        index_capacity = index_capacity > joined->mIndexCount ? index_capacity : joined->mIndexCount;
+
+        __RDUploadMesh(pRd, vertex_capacity, index_capacity, joined->mMeshSize, joined->mIndexCount);
+
+        return;
+    }
+
+    VABind(&pRd->mVArray);
+
+    __RDUploadVertices(pRd, pRd->mVertexCount, joined->mMeshSize - pRd->mVertexCount);
+    __RDUploadIndices(pRd, pRd->mIndexCount, joined->mIndexCount - pRd->mIndexCount);
+
+    VAUnbind();
+
+    pRd->mVertexCount = (uint32_t)joined->mMeshSize;
+    pRd->mIndexCount = (uint32_t)joined->mIndexCount;
+
+    RDUpdateLods(pRd);
+}
+
+/**
+ * @brief Upload next part of joined mesh not uploaded yet (like RDAppendMesh), so big mesh can be uploaded over several frames. Vertices go first and indices after all of them, render data draws only uploaded part until last part (LOD levels are uploaded with first part)
+ * 
+ * @param pRd render data pointer
+ * @param maxVertices most vertices uploaded by call
+ * @param maxIndices most indices uploaded by call
+ * @return true when whole joined mesh is uploaded
+ */
+bool RDAppendMeshChunk(RenderData_t* pRd, size_t maxVertices, size_t maxIndices) {
+    const Mesh_t* joined = &pRd->mMeshPtr->mJoinedMesh;
+
+    bool bounds_changed = pRd->mCompact && (memcmp(pRd->mBoundsMin, joined->mBoundsMin, sizeof(pRd->mBoundsMin)) != 0 || memcmp(pRd->mBoundsMax, joined->mBoundsMax, sizeof(pRd->mBoundsMax)) != 0);
+
+    bool lods_changed = pRd->mLodIndexCount != (joined->mIndexCount != 0 ? __RDLodIndexCount(pRd->mMeshPtr) : 0);
+
+    bool reupload = joined->mMeshSize < pRd->mVertexCount || joined->mIndexCount < pRd->mIndexCount || bounds_changed || lods_changed;
+    bool grow = joined->mMeshSize > pRd->mVertexCapacity || joined->mIndexCount > pRd->mIndexCapacity;
+
+    // recreated buffers lose uploaded part, it is uploaded again chunk by chunk
+    size_t vertex_count = reupload || grow ? 0 : pRd->mVertexCount;
+    size_t index_count = reupload || grow ? 0 : pRd->mIndexCount;
+
+    size_t vertex_end = joined->mMeshSize - vertex_count > maxVertices ? vertex_count + maxVertices : joined->mMeshSize;
+    size_t index_end = index_count;
+
+    if(vertex_end == joined->mMeshSize) {
+        index_end = joined->mIndexCount - index_count > maxIndices ? index_count + maxIndices : joined->mIndexCount;
+    }
+
+    if(reupload) {
+        __RDUploadMesh(pRd, joined->mMeshSize, joined->mIndexCount, vertex_end, index_end);
+    }
+    else if(grow) {
+        size_t vertex_capacity = (size_t)pRd->mVertexCapacity + pRd->mVertexCapacity / 2;
+        size_t index_capacity = (size_t)pRd->mIndexCapacity + pRd->mIndexCapacity / 2;
+
+        vertex_capacity = vertex_capacity > joined->mMeshSize ? vertex_capacity : joined->mMeshSize;
+        index_capacity = index_capacity > joined->mIndexCount ? index_capacity : joined->mIndexCount;
+
+        __RDUploadMesh(pRd, vertex_capacity, index_capacity, vertex_end, index_end);
+    }
+    else {
+        VABind(&pRd->mVArray);
+
+        __RDUploadVertices(pRd, vertex_count, vertex_end - vertex_count);
+        __RDUploadIndices(pRd, index_count, index_end - index_count);
+
+        VAUnbind();
+
+        pRd->mVertexCount = (uint32_t)vertex_end;
+        pRd->mIndexCount = (uint32_t)index_end;
+
+        if(vertex_end == joined->mMeshSize && index_end == joined->mIndexCount) {
+            RDUpdateLods(pRd);
+        }
+        else {
+            pRd->mMultiDraw = false;
+        }
+    }
+
+    return vertex_end == joined->mMeshSize && index_end == joined->mIndexCount;
+}
+
+/**
+ * @brief Rewrite joined vertices of dirty meshes of bound mesh data (see MDUpdate) and upload only their vertex ranges. Whole mesh is uploaded when mesh data had to be rejoined or compact render data bounds grew
+ * 
+ * @param pRd render data pointer
+ */
+void RDUpdateDirty(RenderData_t* pRd) {
+    MeshData_t* data = pRd->mMeshPtr;
+    const Mesh_t* joined = &data->mJoinedMesh;
+
+    if(data->mDirtyCount == 0) {
+        return;
+    }
+
+    bool rewritten = __MDRewriteDirty(data);
+    bool bounds_changed = pRd->mCompact && (memcmp(pRd->mBoundsMin, joined->mBoundsMin, sizeof(pRd->mBoundsMin)) != 0 || memcmp(pRd->mBoundsMax, joined->mBoundsMax, sizeof(pRd->mBoundsMax)) != 0);
+
+    if(!rewritten || bounds_changed || joined->mMeshSize != pRd->mVertexCount) {
+        __MDClearDirty(data);
+        RDUpdateMesh(pRd);
+
+        return;
+    }
+
+    VABind(&pRd->mVArray);
+
+    // neighbouring dirty meshes are uploaded as one range
+    for(uint32_t i = 0; i < data->mMeshCount; i++) {
+        uint32_t end = i;
+
+        while(end < data->mMeshCount && data->mMeshDirty[end]) {
+            end++;
+        }
+
+        if(end != i) {
+            size_t last = end < data->mMeshCount ? data->mMeshStart[end] : joined->mMeshSize;
+
+            __RDUploadVertices(pRd, data->mMeshStart[i], last - data->mMeshStart[i]);
+
+            i = end;
+        }
+    }
+
+    VAUnbind();
+
+    __MDClearDirty(data);
+}
+
+/**
+ * @brief Upload matrices of meshes whose transforms changed (see MDSetGPUTransforms), one matrix per moved mesh. Neighbouring changed meshes are uploaded as one range, all matrices are uploaded when mesh count changed
+ * 
+ * @param pRd render data pointer
+ */
+void RDUpdateTransforms(RenderData_t* pRd) {
+    MeshData_t* data = pRd->mMeshPtr;
+
+    if(!data->mGPUTransforms || (data->mTransformDirtyCount == 0 && pRd->mTransformCount == data->mMeshCount)) {
+        return;
+    }
+
+    if(pRd->mTransformCount != data->mMeshCount) {
+        __RDUploadTransforms(pRd);
+
+        return;
+    }
+
+    for(uint32_t i = 0; i < data->mMeshCount; i++) {
+        uint32_t end = i;
+
+        while(end < data->mMeshCount && data->mTransformDirty[end]) {
+            end++;
+        }
+
+        if(end == i) {
+            continue;
+        }
+
+        // transforms hold more than matrix, so range is staged in chunks
+        mat4_t matrices[64];
+
+        for(uint32_t first = i; first < end; first += 64) {
+            uint32_t count = end - first < 64 ? end - first : 64;
+
+            for(uint32_t j = 0; j < count; j++) {
+                matrices[j] = data->mMeshTransform[first + j].mTransformMat;
+                data->mTransformDirty[first + j] = false;
+            }
+
+            SBBindSubData(&pRd->mTransformBuffer, sizeof(mat4_t) * first, matrices, sizeof(mat4_t) * count);
+        }
+
+        i = end;
+    }
+
+    data->mTransformDirtyCount = 0;
+}
+
+/**
+ * @brief Select LOD level of every submesh of bound mesh data (see MDSelectLods) and rebuild draws when selection changed, call once per frame
+ * 
+ * @param pRd render data pointer
+ * @param camera camera position in joined mesh space
+ * @param projectionScale viewport height / (2 * tan(fov / 2))
+ * @param threshold largest allowed error in pixels
+ */
+void RDSelectLods(RenderData_t* pRd, vec4_t camera, float projectionScale, float threshold) {
+    if(MDSelectLods(pRd->mMeshPtr, camera, projectionScale, threshold)) {
+        RDUpdateLods(pRd);
+    }
+}
+
+/**
+ * @brief Set vertex format of render data (e.g. RDInterleavedFormat or own mix of streams), bound mesh is reuploaded. Integer positions are quantized inside joined mesh bounds and decoded by RRender through uPositionOffset/uPositionScale uniforms, 2 component normals are octahedral
+ * 
+ * @param pRd render data pointer
+ * @param pFormat vertex format, copied into render data
+ */
+void RDSetFormat(RenderData_t* pRd, const VertexFormat_t* pFormat) {
+    uint32_t position_type = pFormat->mAttributes[0].mType;
+
+    if(pFormat->mStreamCount == 0) {
+        E_WARN("Vertex format has no attributes, it is not set!");
+
+        return;
+    }
+
+    pRd->mFormat = *pFormat;
+    pRd->mCompact = pFormat->mAttributes[0].mDimmensions != 0 && position_type != GL_FLOAT && position_type != GL_HALF_FLOAT;
+
+    if(pRd->mMeshPtr != nullptr) {
+        // attribute formats change, so vertex array is recreated instead of patched
+        VADelete(&pRd->mVArray);
+        RDUpdateMesh(pRd);
+    }
+}
+
+/**
+ * @brief Switch render data between float streams and 16 byte quantized vertices (see RDCompactFormat), bound mesh is reuploaded
+ * 
+ * @param pRd render data pointer
+ * @param compact use compact vertices
+ */
+void RDSetCompact(RenderData_t* pRd, bool compact) {
+    if(pRd->mCompact == compact) {
+        return;
+    }
+
+    VertexFormat_t format = compact ? RDCompactFormat() : RDSeparateFormat();
+
+    RDSetFormat(pRd, &format);
+}
+
+/**
+ * @brief Upload source buffer (e.g. whole .glb BIN chunk) as is and draw it through given draws, vertices are not converted or joined. Render data must not have bound mesh
+ * 
+ * @param pRd render data pointer
+ * @param data source buffer
+ * @param size source buffer size in bytes
+ * @param draws draws, copied into render data
+ * @param drawCount draws amount
+ */
+void RDBindSource(RenderData_t* pRd, const void* data, size_t size, const RDSourceDraw_t* draws, uint32_t drawCount) {
+    VABind(&pRd->mVArray);
+
+    VBBindData(&pRd->mSourceBuffer, (void*)data, (uint32_t)size);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, pRd->mSourceBuffer.mId);
+
+    VAUnbind();
+
+    // source attributes keep own formats, compact decoding would misread them
+    pRd->mCompact = false;
+    pRd->mSourceDraws = MECRealloc(pRd->mSourceDraws, sizeof(RDSourceDraw_t) * drawCount);
+    pRd->mSourceDrawCount = drawCount;
+
+    memcpy(pRd->mSourceDraws, draws, sizeof(RDSourceDraw_t) * drawCount);
+}
+
+/**
+ * @brief Points vertex attributes of bound vertex array at source draw, missing attributes get constant defaults (white color, zero normal and texture coordinates)
+ * 
+ * @param pRd render data pointer
+ * @param pDraw source draw
+ */
+void __RDBindSourceDraw(RenderData_t* pRd, const RDSourceDraw_t* pDraw) {
+    for(uint32_t i = 0; i < 4; i++) {
+        const RDSourceAttribute_t* attribute = &pDraw->mAttributes[i];
+
+        if(attribute->mType == 0) {
+            __RDSetAttributeDefault(i);
+
+            continue;
+        }
+
+        VBBindPlaceFormat(&pRd->mSourceBuffer, i, attribute->mDimmensions, attribute->mType, attribute->mNormalized, attribute->mStride, attribute->mOffset);
+    }
+
+    for(uint32_t i = 4; i < VF_MAX_ATTRIBUTES; i++) {
+        __RDSetAttributeDefault(i);
+    }
 }
 
 void RDBindMesh(RenderData_t* pRd, MeshData_t* pMesh) {
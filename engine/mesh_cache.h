@@ -0,0 +1,468 @@
+#ifndef _EFFECTIVE_MESH_CACHE_
+#define _EFFECTIVE_MESH_CACHE_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "core.h"
+#include "mesh.h"
+#include "mesh_optimize.h"
+
+#define MC_MAGIC "EMSH"
+#define MC_VERSION 8
+#define MC_BYTE_ORDER 0x01020304u
+#define MC_ALIGNMENT 64
+#define MC_MAX_PATH 4096
+
+/**
+ * @brief .emesh file header, followed by source path and mesh streams (each aligned to MC_ALIGNMENT) in exact Mesh_t layout. Index stream holds LOD levels after full mesh indices, meshlet stream is last
+ */
+typedef struct MeshCacheHeader_s {
+    char mMagic[4];
+    uint32_t mVersion;
+    uint32_t mByteOrder;
+    uint32_t mPathSize;
+
+    uint64_t mSourceSize;
+    int64_t mSourceTime;
+    uint64_t mSourceHash;
+
+    uint64_t mVertexCount;
+    uint64_t mIndexCount;
+    float mBoundsMin[3];
+    float mBoundsMax[3];
+
+    uint32_t mLodCount;
+    uint32_t mCooked;
+    uint32_t mIndexed;
+    float mLodError[M_MAX_LODS];
+    uint64_t mLodIndexOffset[M_MAX_LODS];
+    uint64_t mLodIndexCount[M_MAX_LODS];
+    uint64_t mIndexEnd;
+    uint64_t mMeshletCount;
+
+    uint64_t mVerticesOffset;
+    uint64_t mNormalsOffset;
+    uint64_t mTextureCoordinatesOffset;
+    uint64_t mColorsOffset;
+    uint64_t mIndicesOffset;
+    uint64_t mMeshletsOffset;
+    uint64_t mFileSize;
+} MeshCacheHeader_t;
+
+// counter of cache files written by this process, makes temporary names unique together with process ID
+atomic_uint gMCTempCounter = 0;
+
+/**
+ * @brief Mapped .emesh file, stream pointers point straight into mapping and are valid until MCClose
+ */
+typedef struct MeshCache_s {
+    FileMap_t mFile;
+    const MeshCacheHeader_t* mHeader;
+
+    const float* mVertices;
+    const float* mNormals;
+    const float* mTextureCoordinates;
+    const float* mColors;
+    const uint32_t* mIndices;
+    const Meshlet_t* mMeshlets;
+} MeshCache_t;
+
+/**
+ * @brief Fills source key of cache header (path, size, modification time and content hash)
+ *
+ * @param pHeader header pointer
+ * @param sourcePath source file path
+ * @return true when source file can be read
+ */
+bool __MCSourceKey(MeshCacheHeader_t* pHeader, const char* sourcePath) {
+    FileMap_t source;
+
+    if(!FMGetInfo(sourcePath, &pHeader->mSourceSize, &pHeader->mSourceTime) || !FMOpen(&source, sourcePath)) {
+        return false;
+    }
+
+    pHeader->mSourceHash = CHashFNV1a(source.mData, source.mSize);
+    pHeader->mPathSize = (uint32_t)strlen(sourcePath);
+
+    FMClose(&source);
+
+    return true;
+}
+
+/**
+ * @brief Check that count elements at offset lie inside file, without overflowing on corrupted values
+ *
+ * @param offset block offset
+ * @param count elements amount
+ * @param elementSize element size in bytes
+ * @param fileSize file size
+ * @return true when block is inside file
+ */
+bool __MCBlockValid(uint64_t offset, uint64_t count, uint64_t elementSize, uint64_t fileSize) {
+    return offset <= fileSize && count <= (fileSize - offset) / elementSize;
+}
+
+/**
+ * @brief Check every offset and count of header against file size, so streams of mapped cache are never read out of file
+ *
+ * @param pHeader header pointer
+ * @param fileSize mapped file size
+ * @return true when header describes blocks inside file
+ */
+bool __MCHeaderValid(const MeshCacheHeader_t* pHeader, uint64_t fileSize) {
+    bool valid = pHeader->mFileSize == fileSize && __MCBlockValid(sizeof(MeshCacheHeader_t), pHeader->mPathSize, 1, fileSize);
+
+    valid = valid && __MCBlockValid(pHeader->mVerticesOffset, pHeader->mVertexCount, sizeof(float) * 3, fileSize);
+    valid = valid && __MCBlockValid(pHeader->mNormalsOffset, pHeader->mVertexCount, sizeof(float) * 3, fileSize);
+    valid = valid && __MCBlockValid(pHeader->mTextureCoordinatesOffset, pHeader->mVertexCount, sizeof(float) * 2, fileSize);
+    valid = valid && __MCBlockValid(pHeader->mColorsOffset, pHeader->mVertexCount, sizeof(float) * 4, fileSize);
+    valid = valid && __MCBlockValid(pHeader->mIndicesOffset, pHeader->mIndexEnd, sizeof(uint32_t), fileSize);
+    valid = valid && __MCBlockValid(pHeader->mMeshletsOffset, pHeader->mMeshletCount, sizeof(Meshlet_t), fileSize);
+    valid = valid && pHeader->mIndexCount <= pHeader->mIndexEnd && pHeader->mLodCount <= M_MAX_LODS;
+    // streams keep write order, RDBindMeshCache uploads them as one block starting at vertices
+    valid = valid && pHeader->mVerticesOffset <= pHeader->mNormalsOffset && pHeader->mNormalsOffset <= pHeader->mTextureCoordinatesOffset;
+    valid = valid && pHeader->mTextureCoordinatesOffset <= pHeader->mColorsOffset && pHeader->mColorsOffset <= pHeader->mIndicesOffset;
+
+    for(uint32_t l = 0; l < pHeader->mLodCount && valid; l++) {
+        valid = pHeader->mLodIndexOffset[l] <= pHeader->mIndexEnd && pHeader->mLodIndexCount[l] <= pHeader->mIndexEnd - pHeader->mLodIndexOffset[l];
+    }
+
+    return valid;
+}
+
+uint64_t __MCAlign(uint64_t offset) {
+    return (offset + MC_ALIGNMENT - 1) & ~(uint64_t)(MC_ALIGNMENT - 1);
+}
+
+/**
+ * @brief Save mesh into .emesh cache file keyed by source file
+ *
+ * @param pMesh mesh pointer
+ * @param cachePath .emesh file path
+ * @param sourcePath path of file mesh was loaded from
+ * @param indexed mesh was loaded as indexed mesh (it can still have no indices)
+ * @param cooked mesh was cooked with MOCookMesh
+ * @return true when cache was written
+ */
+bool MCSaveMesh(const Mesh_t* pMesh, const char* cachePath, const char* sourcePath, bool indexed, bool cooked) {
+    MeshCacheHeader_t header;
+    memset(&header, 0, sizeof(MeshCacheHeader_t));
+
+    if(!__MCSourceKey(&header, sourcePath)) {
+        E_WARN_ARG("Cannot read mesh source \"%s\", cache is not written!", sourcePath);
+
+        return false;
+    }
+
+    memcpy(header.mMagic, MC_MAGIC, 4);
+    header.mVersion = MC_VERSION;
+    header.mByteOrder = MC_BYTE_ORDER;
+    header.mVertexCount = pMesh->mMeshSize;
+    header.mIndexCount = pMesh->mIndexCount;
+    memcpy(header.mBoundsMin, pMesh->mBoundsMin, sizeof(header.mBoundsMin));
+    memcpy(header.mBoundsMax, pMesh->mBoundsMax, sizeof(header.mBoundsMax));
+
+    header.mLodCount = pMesh->mLodCount;
+    header.mCooked = cooked;
+    header.mIndexed = indexed;
+    header.mIndexEnd = MLodIndexEnd(pMesh);
+    header.mMeshletCount = pMesh->mMeshletCount;
+
+    for(uint32_t l = 0; l < pMesh->mLodCount; l++) {
+        header.mLodError[l] = pMesh->mLods[l].mError;
+        header.mLodIndexOffset[l] = pMesh->mLods[l].mIndexOffset;
+        header.mLodIndexCount[l] = pMesh->mLods[l].mIndexCount;
+    }
+
+    header.mVerticesOffset = __MCAlign(sizeof(MeshCacheHeader_t) + header.mPathSize);
+    header.mNormalsOffset = __MCAlign(header.mVerticesOffset + sizeof(float) * 3 * header.mVertexCount);
+    header.mTextureCoordinatesOffset = __MCAlign(header.mNormalsOffset + sizeof(float) * 3 * header.mVertexCount);
+    header.mColorsOffset = __MCAlign(header.mTextureCoordinatesOffset + sizeof(float) * 2 * header.mVertexCount);
+    header.mIndicesOffset = __MCAlign(header.mColorsOffset + sizeof(float) * 4 * header.mVertexCount);
+    header.mMeshletsOffset = __MCAlign(header.mIndicesOffset + sizeof(uint32_t) * header.mIndexEnd);
+    header.mFileSize = header.mMeshletsOffset + sizeof(Meshlet_t) * header.mMeshletCount;
+
+    // cache is written under unique name and renamed, so concurrent loads of one model never see half written cache
+    char temp_path[MC_MAX_PATH];
+
+#ifdef _WIN32
+    unsigned long process = (unsigned long)GetCurrentProcessId();
+#else
+    unsigned long process = (unsigned long)getpid();
+#endif
+
+    if(snprintf(temp_path, MC_MAX_PATH, "%s.%lu.%u.tmp", cachePath, process, atomic_fetch_add(&gMCTempCounter, 1)) >= MC_MAX_PATH) {
+        return false;
+    }
+
+    FILE* file = fopen(temp_path, "wb");
+
+    if(file == nullptr) {
+        E_WARN_ARG("Cannot create mesh cache \"%s\"!", cachePath);
+
+        return false;
+    }
+
+    const void* streams[] = { pMesh->mVertices, pMesh->mNormals, pMesh->mTextureCoordinates, pMesh->mColors, pMesh->mIndices, pMesh->mMeshlets };
+    const uint64_t offsets[] = { header.mVerticesOffset, header.mNormalsOffset, header.mTextureCoordinatesOffset, header.mColorsOffset, header.mIndicesOffset, header.mMeshletsOffset };
+    const uint64_t sizes[] = { sizeof(float) * 3 * header.mVertexCount, sizeof(float) * 3 * header.mVertexCount, sizeof(float) * 2 * header.mVertexCount, sizeof(float) * 4 * header.mVertexCount, sizeof(uint32_t) * header.mIndexEnd, sizeof(Meshlet_t) * header.mMeshletCount };
+    const uint8_t padding[MC_ALIGNMENT] = {0};
+
+    bool written = fwrite(&header, sizeof(MeshCacheHeader_t), 1, file) == 1 && fwrite(sourcePath, 1, header.mPathSize, file) == header.mPathSize;
+    uint64_t position = sizeof(MeshCacheHeader_t) + header.mPathSize;
+
+    for(uint32_t i = 0; i < 6 && written; i++) {
+        written = fwrite(padding, 1, offsets[i] - position, file) == offsets[i] - position;
+        written = written && (sizes[i] == 0 || fwrite(streams[i], 1, sizes[i], file) == sizes[i]);
+        position = offsets[i] + sizes[i];
+    }
+
+    written = fclose(file) == 0 && written;
+
+#ifdef _WIN32
+    if(written) {
+        remove(cachePath);
+    }
+#endif
+
+    if(!written || rename(temp_path, cachePath) != 0) {
+        E_WARN_ARG("Cannot write mesh cache \"%s\"!", cachePath);
+
+        remove(temp_path);
+
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Check mapped cache against source (version, blocks, path and size), modification time is checked by caller
+ *
+ * @param pCache mesh cache pointer with mapped file
+ * @param sourcePath source file path
+ * @param sourceSize source file size
+ * @return true when cache matches source
+ */
+bool __MCMatchesSource(const MeshCache_t* pCache, const char* sourcePath, uint64_t sourceSize) {
+    const MeshCacheHeader_t* header = (const MeshCacheHeader_t*)pCache->mFile.mData;
+    size_t path_size = strlen(sourcePath);
+
+    bool valid = pCache->mFile.mSize >= sizeof(MeshCacheHeader_t) && memcmp(header->mMagic, MC_MAGIC, 4) == 0 && header->mVersion == MC_VERSION && header->mByteOrder == MC_BYTE_ORDER;
+    valid = valid && __MCHeaderValid(header, pCache->mFile.mSize);
+    valid = valid && header->mPathSize == path_size && memcmp(pCache->mFile.mData + sizeof(MeshCacheHeader_t), sourcePath, path_size) == 0;
+
+    return valid && header->mSourceSize == sourceSize;
+}
+
+/**
+ * @brief Compare content hash of source with cache whose source modification time differs (e.g. after touch), matching cache gets new time in header so next launches don`t hash source again
+ *
+ * @param cachePath .emesh file path
+ * @param sourcePath source file path
+ * @param sourceTime source modification time
+ * @return true when source content matches cache
+ */
+bool __MCRefreshSourceTime(const char* cachePath, const char* sourcePath, int64_t sourceTime) {
+    MeshCacheHeader_t header, key;
+    FILE* file = fopen(cachePath, "r+b");
+
+    if(file == nullptr) {
+        return false;
+    }
+
+    bool matches = fread(&header, sizeof(MeshCacheHeader_t), 1, file) == 1 && __MCSourceKey(&key, sourcePath) && key.mSourceHash == header.mSourceHash;
+
+    if(matches && fseek(file, (long)offsetof(MeshCacheHeader_t, mSourceTime), SEEK_SET) == 0 && fwrite(&sourceTime, sizeof(int64_t), 1, file) != 1) {
+        E_WARN_ARG("Cannot refresh mesh cache \"%s\", source will be hashed again on next load!", cachePath);
+    }
+
+    fclose(file);
+
+    return matches;
+}
+
+/**
+ * @brief Map .emesh cache file, cache is rejected when it is from other version, any of its blocks lies out of file or its source path, size, modification time don`t match. When only modification time differs source content hash decides and matching cache gets new time
+ *
+ * @param pCache mesh cache pointer
+ * @param cachePath .emesh file path
+ * @param sourcePath source file path
+ * @return true when cache is valid for source
+ */
+bool MCOpen(MeshCache_t* pCache, const char* cachePath, const char* sourcePath) {
+    memset(pCache, 0, sizeof(MeshCache_t));
+
+    uint64_t cache_size = 0, source_size = 0;
+    int64_t cache_time = 0, source_time = 0;
+
+    if(!FMGetInfo(cachePath, &cache_size, &cache_time) || cache_size < sizeof(MeshCacheHeader_t) || !FMGetInfo(sourcePath, &source_size, &source_time)) {
+        return false;
+    }
+
+    if(!FMOpen(&pCache->mFile, cachePath)) {
+        return false;
+    }
+
+    bool valid = __MCMatchesSource(pCache, sourcePath, source_size);
+
+    if(valid && ((const MeshCacheHeader_t*)pCache->mFile.mData)->mSourceTime != source_time) {
+        // mapping is closed while header is rewritten, mapped files can`t be written on Windows
+        FMClose(&pCache->mFile);
+
+        valid = __MCRefreshSourceTime(cachePath, sourcePath, source_time) && FMOpen(&pCache->mFile, cachePath) && __MCMatchesSource(pCache, sourcePath, source_size);
+    }
+
+    const MeshCacheHeader_t* header = (const MeshCacheHeader_t*)pCache->mFile.mData;
+
+    if(!valid) {
+        FMClose(&pCache->mFile);
+
+        return false;
+    }
+
+    pCache->mHeader = header;
+    pCache->mVertices = (const float*)(pCache->mFile.mData + header->mVerticesOffset);
+    pCache->mNormals = (const float*)(pCache->mFile.mData + header->mNormalsOffset);
+    pCache->mTextureCoordinates = (const float*)(pCache->mFile.mData + header->mTextureCoordinatesOffset);
+    pCache->mColors = (const float*)(pCache->mFile.mData + header->mColorsOffset);
+    pCache->mIndices = header->mIndexCount == 0 ? nullptr : (const uint32_t*)(pCache->mFile.mData + header->mIndicesOffset);
+    pCache->mMeshlets = header->mMeshletCount == 0 ? nullptr : (const Meshlet_t*)(pCache->mFile.mData + header->mMeshletsOffset);
+
+    for(uint64_t m = 0; m < header->mMeshletCount; m++) {
+        if((uint64_t)pCache->mMeshlets[m].mIndexOffset + pCache->mMeshlets[m].mIndexCount > header->mIndexCount) {
+            FMClose(&pCache->mFile);
+            memset(pCache, 0, sizeof(MeshCache_t));
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void MCClose(MeshCache_t* pCache) {
+    FMClose(&pCache->mFile);
+
+    memset(pCache, 0, sizeof(MeshCache_t));
+}
+
+/**
+ * @brief Append mapped cache contents to mesh, streams are copied as whole blocks without any parsing. LOD levels and meshlets are kept when mesh is empty (see MAppendMesh)
+ *
+ * @param pCache mapped mesh cache
+ * @param pMesh mesh pointer
+ */
+void MCCopyToMesh(const MeshCache_t* pCache, Mesh_t* pMesh) {
+    Mesh_t view;
+    MClearMesh(&view);
+
+    view.mVertices = (float*)pCache->mVertices;
+    view.mNormals = (float*)pCache->mNormals;
+    view.mTextureCoordinates = (float*)pCache->mTextureCoordinates;
+    view.mColors = (float*)pCache->mColors;
+    view.mMeshSize = (size_t)pCache->mHeader->mVertexCount;
+    view.mIndices = (uint32_t*)pCache->mIndices;
+    view.mIndexCount = (size_t)pCache->mHeader->mIndexCount;
+    view.mLodCount = pCache->mHeader->mLodCount;
+    view.mMeshlets = (Meshlet_t*)pCache->mMeshlets;
+    view.mMeshletCount = (uint32_t)pCache->mHeader->mMeshletCount;
+
+    for(uint32_t l = 0; l < view.mLodCount; l++) {
+        view.mLods[l] = (MeshLod_t){ (size_t)pCache->mHeader->mLodIndexOffset[l], (size_t)pCache->mHeader->mLodIndexCount[l], pCache->mHeader->mLodError[l] };
+    }
+
+    memcpy(view.mBoundsMin, pCache->mHeader->mBoundsMin, sizeof(view.mBoundsMin));
+    memcpy(view.mBoundsMax, pCache->mHeader->mBoundsMax, sizeof(view.mBoundsMax));
+
+    MAppendMesh(pMesh, &view);
+}
+
+/**
+ * @brief Upload mapped cache streams straight to render data source buffer and draw full detail mesh from it, vertices are not copied into Mesh_t or joined (see RDBindSource). Cache can be closed afterwards
+ *
+ * @param pRd render data pointer, must not have bound mesh
+ * @param pCache mapped mesh cache
+ */
+void RDBindMeshCache(RenderData_t* pRd, const MeshCache_t* pCache) {
+    const MeshCacheHeader_t* header = pCache->mHeader;
+    uint64_t first = header->mVerticesOffset;
+    RDSourceDraw_t draw;
+    memset(&draw, 0, sizeof(RDSourceDraw_t));
+
+    // streams are uploaded as one block from vertices to end of indices, so offsets are relative to vertex stream
+    draw.mAttributes[0] = (RDSourceAttribute_t){ (size_t)(header->mVerticesOffset - first), sizeof(float) * 3, GL_FLOAT, 3, false };
+    draw.mAttributes[1] = (RDSourceAttribute_t){ (size_t)(header->mColorsOffset - first), sizeof(float) * 4, GL_FLOAT, 4, false };
+    draw.mAttributes[2] = (RDSourceAttribute_t){ (size_t)(header->mNormalsOffset - first), sizeof(float) * 3, GL_FLOAT, 3, false };
+    draw.mAttributes[3] = (RDSourceAttribute_t){ (size_t)(header->mTextureCoordinatesOffset - first), sizeof(float) * 2, GL_FLOAT, 2, false };
+
+    draw.mMode = GL_TRIANGLES;
+    draw.mIndexType = header->mIndexed != 0 ? GL_UNSIGNED_INT : 0;
+    draw.mIndexOffset = (size_t)(header->mIndicesOffset - first);
+    draw.mCount = (uint32_t)(header->mIndexed != 0 ? header->mIndexCount : header->mVertexCount);
+
+    RDBindSource(pRd, pCache->mFile.mData + first, (size_t)(header->mIndicesOffset + sizeof(uint32_t) * header->mIndexEnd - first), &draw, 1);
+}
+
+/**
+ * @brief Load .ply model through .emesh cache stored next to it ("<path>.emesh"). Valid cache is mapped and copied, otherwise model is parsed (and cooked with MOCookMesh when asked) and cache is written for next launch. Cache made with other indexed or cook options is rewritten. Renderers that don`t need Mesh_t can skip the copy with MCOpen and RDBindMeshCache
+ *
+ * @param pMesh mesh pointer
+ * @param path .ply file path
+ * @param indexed load as indexed mesh (see MLoadPLYIndexedMeshFromFile)
+ * @param cook weld, build LODs, optimize and split indexed mesh into meshlets (see MOCookMesh), otherwise geometry stays as in file
+ */
+void MLoadPLYMeshCached(Mesh_t* pMesh, const char* path, bool indexed, bool cook) {
+    char cache_path[MC_MAX_PATH];
+    MeshCache_t cache;
+
+    if(snprintf(cache_path, MC_MAX_PATH, "%s.emesh", path) >= MC_MAX_PATH) {
+        E_WARN_ARG("Mesh path \"%s\" is too long for cache!", path);
+
+        __MLoadPLYMeshFromFile(pMesh, path, indexed);
+
+        return;
+    }
+
+    // cooking only touches indexed meshes, so de-indexed cache is the same either way
+    cook = cook && indexed;
+
+    if(MCOpen(&cache, cache_path, path) && (cache.mHeader->mIndexed != 0) == indexed && (cache.mHeader->mCooked != 0) == cook) {
+        MCCopyToMesh(&cache, pMesh);
+        MCClose(&cache);
+
+        return;
+    }
+
+    if(cache.mHeader != nullptr) {
+        MCClose(&cache);
+    }
+
+    Mesh_t loaded;
+    MClearMesh(&loaded);
+
+    __MLoadPLYMeshFromFile(&loaded, path, indexed);
+
+    if(cook && loaded.mIndexCount != 0) {
+        MOCookMesh(&loaded);
+    }
+
+    if(loaded.mMeshSize != 0) {
+        MCSaveMesh(&loaded, cache_path, path, indexed, cook);
+    }
+
+    if(pMesh->mMeshCapacity == 0 && pMesh->mIndexCapacity == 0) {
+        *pMesh = loaded;
+
+        return;
+    }
+
+    MAppendMesh(pMesh, &loaded);
+
+    if(loaded.mMeshCapacity != 0) {
+        MFreeMesh(&loaded);
+    }
+}
+
+#endif
@@ -0,0 +1,1188 @@
+#ifndef _EFFECTIVE_MESH_OPTIMIZE_
+#define _EFFECTIVE_MESH_OPTIMIZE_
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "core.h"
+#include "mesh.h"
+
+#define MO_CACHE_SIZE 32
+#define MO_FIFO_CACHE_SIZE 16
+#define MO_OVERDRAW_THRESHOLD 1.05f
+
+/**
+ * @brief Simulates FIFO post transform cache for one triangle
+ *
+ * @param timestamps per vertex time of last cache insertion
+ * @param pTime current cache time
+ * @param triangle triangle indices
+ * @param cacheSize FIFO cache size
+ * @return uint32_t amount of cache misses (0 - 3)
+ */
+uint32_t __MOFifoTriangle(uint32_t* timestamps, uint32_t* pTime, const uint32_t* triangle, uint32_t cacheSize) {
+    uint32_t misses = 0;
+
+    for(uint32_t c = 0; c < 3; c++) {
+        if(*pTime - timestamps[triangle[c]] > cacheSize) {
+            timestamps[triangle[c]] = (*pTime)++;
+            misses++;
+        }
+    }
+
+    return misses;
+}
+
+/**
+ * @brief Calculate average cache miss ratio (transformed vertices per triangle) of index buffer on FIFO cache, 0.5 is best possible for big regular meshes and 3 is worst
+ *
+ * @param indices triangle indices
+ * @param indexCount indices amount
+ * @param vertexCount vertices amount
+ * @param cacheSize FIFO cache size
+ * @return float ACMR
+ */
+float MOCalculateACMR(const uint32_t* indices, size_t indexCount, size_t vertexCount, uint32_t cacheSize) {
+    if(indexCount < 3) {
+        return 0.0f;
+    }
+
+    uint32_t* timestamps = (uint32_t*)MECCalloc(vertexCount, sizeof(uint32_t));
+    uint32_t time = cacheSize + 1;
+    size_t misses = 0;
+
+    for(size_t i = 0; i + 2 < indexCount; i += 3) {
+        misses += __MOFifoTriangle(timestamps, &time, &indices[i], cacheSize);
+    }
+
+    MECFree(timestamps);
+
+    return (float)misses / (float)(indexCount / 3);
+}
+
+/**
+ * @brief Forsyth vertex score from LRU cache position (-1 when not cached) and amount of not emitted triangles using vertex
+ *
+ * @param cachePosition
+ * @param remaining
+ * @return float
+ */
+float __MOVertexScore(int32_t cachePosition, uint32_t remaining) {
+    if(remaining == 0) {
+        return -1.0f;
+    }
+
+    float score = 0.0f;
+
+    if(cachePosition >= 0) {
+        // last triangle vertices get fixed score, so next triangle is not chosen by strip order only
+        score = cachePosition < 3 ? 0.75f : powf(1.0f - (float)(cachePosition - 3) / (float)(MO_CACHE_SIZE - 3), 1.5f);
+    }
+
+    return score + 2.0f / sqrtf((float)remaining);
+}
+
+/**
+ * @brief Reorder triangles for post transform vertex cache locality (Tom Forsyth linear speed optimizer), runs in place
+ *
+ * @param indices triangle indices
+ * @param indexCount indices amount
+ * @param vertexCount vertices amount
+ */
+void MOOptimizeVertexCache(uint32_t* indices, size_t indexCount, size_t vertexCount) {
+    size_t triangle_count = indexCount / 3;
+
+    if(triangle_count < 2 || vertexCount == 0) {
+        return;
+    }
+
+    // triangles using every vertex, remaining ones are kept at front of vertex range
+    uint32_t* adjacency_offset = (uint32_t*)MECCalloc(vertexCount + 1, sizeof(uint32_t));
+    uint32_t* remaining = (uint32_t*)MECCalloc(vertexCount, sizeof(uint32_t));
+    uint32_t* adjacency = (uint32_t*)MECMalloc(sizeof(uint32_t) * triangle_count * 3);
+
+    for(size_t i = 0; i < triangle_count * 3; i++) {
+        adjacency_offset[indices[i] + 1]++;
+    }
+
+    for(size_t v = 0; v < vertexCount; v++) {
+        adjacency_offset[v + 1] += adjacency_offset[v];
+    }
+
+    for(size_t i = 0; i < triangle_count * 3; i++) {
+        adjacency[adjacency_offset[indices[i]] + remaining[indices[i]]++] = (uint32_t)(i / 3);
+    }
+
+    int32_t* cache_position = (int32_t*)MECMalloc(sizeof(int32_t) * vertexCount);
+    float* vertex_score = (float*)MECMalloc(sizeof(float) * vertexCount);
+    bool* emitted = (bool*)MECCalloc(triangle_count, sizeof(bool));
+    uint32_t* result = (uint32_t*)MECMalloc(sizeof(uint32_t) * triangle_count * 3);
+
+    for(size_t v = 0; v < vertexCount; v++) {
+        cache_position[v] = -1;
+        vertex_score[v] = __MOVertexScore(-1, remaining[v]);
+    }
+
+    uint32_t cache[MO_CACHE_SIZE + 3];
+    uint32_t cache_count = 0;
+    size_t cursor = 0;
+    int64_t best = -1;
+
+    for(size_t out = 0; out < triangle_count; out++) {
+        if(best < 0) {
+            // cache gave no candidate, continue with next triangle in input order
+            while(emitted[cursor]) {
+                cursor++;
+            }
+
+            best = (int64_t)cursor;
+        }
+
+        const uint32_t* triangle = &indices[best * 3];
+        memcpy(&result[out * 3], triangle, sizeof(uint32_t) * 3);
+        emitted[best] = true;
+
+        for(uint32_t c = 0; c < 3; c++) {
+            uint32_t* list = &adjacency[adjacency_offset[triangle[c]]];
+
+            for(uint32_t j = 0; j < remaining[triangle[c]]; j++) {
+                if(list[j] == (uint32_t)best) {
+                    list[j] = list[--remaining[triangle[c]]];
+
+                    break;
+                }
+            }
+        }
+
+        uint32_t new_cache[MO_CACHE_SIZE + 3];
+        uint32_t new_count = 0;
+
+        for(uint32_t c = 0; c < 3; c++) {
+            if(new_count == 0 || (new_cache[0] != triangle[c] && (new_count < 2 || new_cache[1] != triangle[c]))) {
+                new_cache[new_count++] = triangle[c];
+            }
+        }
+
+        for(uint32_t j = 0; j < cache_count; j++) {
+            uint32_t vertex = cache[j];
+
+            if(vertex != triangle[0] && vertex != triangle[1] && vertex != triangle[2]) {
+                new_cache[new_count++] = vertex;
+            }
+        }
+
+        for(uint32_t j = 0; j < new_count; j++) {
+            uint32_t vertex = new_cache[j];
+
+            cache_position[vertex] = j < MO_CACHE_SIZE ? (int32_t)j : -1;
+            vertex_score[vertex] = __MOVertexScore(cache_position[vertex], remaining[vertex]);
+        }
+
+        best = -1;
+        float best_score = -1.0f;
+
+        for(uint32_t j = 0; j < new_count; j++) {
+            uint32_t vertex = new_cache[j];
+            const uint32_t* list = &adjacency[adjacency_offset[vertex]];
+
+            for(uint32_t k = 0; k < remaining[vertex]; k++) {
+                const uint32_t* candidate = &indices[list[k] * 3];
+                float score = vertex_score[candidate[0]] + vertex_score[candidate[1]] + vertex_score[candidate[2]];
+
+                if(score > best_score) {
+                    best_score = score;
+                    best = list[k];
+                }
+            }
+        }
+
+        cache_count = new_count < MO_CACHE_SIZE ? new_count : MO_CACHE_SIZE;
+        memcpy(cache, new_cache, sizeof(uint32_t) * cache_count);
+    }
+
+    memcpy(indices, result, sizeof(uint32_t) * triangle_count * 3);
+
+    MECFree(result);
+    MECFree(emitted);
+    MECFree(vertex_score);
+    MECFree(cache_position);
+    MECFree(adjacency);
+    MECFree(remaining);
+    MECFree(adjacency_offset);
+}
+
+typedef struct MOCluster_s {
+    size_t mStart;
+    size_t mEnd;
+    float mSortKey;
+} MOCluster_t;
+
+int __MOCompareClusters(const void* pA, const void* pB) {
+    float a = ((const MOCluster_t*)pA)->mSortKey;
+    float b = ((const MOCluster_t*)pB)->mSortKey;
+
+    return a < b ? 1 : (a > b ? -1 : 0);
+}
+
+/**
+ * @brief Reorder clusters of vertex cache optimized triangles to reduce overdraw (view independent, Sander et al. "Fast Triangle Reordering"). Outward facing clusters far from mesh center are drawn first, so they occlude rest of mesh from most directions. Run after MOOptimizeVertexCache
+ *
+ * @param indices triangle indices
+ * @param indexCount indices amount
+ * @param vertices vertex positions (3 floats per vertex)
+ * @param vertexCount vertices amount
+ * @param threshold allowed ACMR growth, e.g. MO_OVERDRAW_THRESHOLD (1.05 allows 5% worse vertex cache use for smaller clusters)
+ */
+void MOOptimizeOverdraw(uint32_t* indices, size_t indexCount, const float* vertices, size_t vertexCount, float threshold) {
+    size_t triangle_count = indexCount / 3;
+
+    if(triangle_count < 2 || vertexCount == 0) {
+        return;
+    }
+
+    uint32_t* timestamps = (uint32_t*)MECCalloc(vertexCount, sizeof(uint32_t));
+    uint32_t time = MO_FIFO_CACHE_SIZE + 1;
+
+    // hard boundaries are where vertex cache optimizer restarted (triangle without cached vertices)
+    size_t* hard = (size_t*)MECMalloc(sizeof(size_t) * (triangle_count + 1));
+    size_t hard_count = 0;
+
+    for(size_t t = 0; t < triangle_count; t++) {
+        if(__MOFifoTriangle(timestamps, &time, &indices[t * 3], MO_FIFO_CACHE_SIZE) == 3) {
+            hard[hard_count++] = t;
+        }
+    }
+
+    hard[hard_count] = triangle_count;
+
+    // soft boundaries split hard clusters where cache use is already close to whole cluster
+    MOCluster_t* clusters = (MOCluster_t*)MECMalloc(sizeof(MOCluster_t) * triangle_count);
+    size_t cluster_count = 0;
+
+    for(size_t h = 0; h < hard_count; h++) {
+        size_t start = hard[h], end = hard[h + 1];
+        size_t cluster_misses = 0;
+
+        time += MO_FIFO_CACHE_SIZE + 1;
+
+        for(size_t t = start; t < end; t++) {
+            cluster_misses += __MOFifoTriangle(timestamps, &time, &indices[t * 3], MO_FIFO_CACHE_SIZE);
+        }
+
+        float cluster_threshold = threshold * (float)cluster_misses / (float)(end - start);
+        size_t running_misses = 0, running_triangles = 0;
+
+        clusters[cluster_count].mStart = start;
+        time += MO_FIFO_CACHE_SIZE + 1;
+
+        for(size_t t = start; t < end; t++) {
+            running_misses += __MOFifoTriangle(timestamps, &time, &indices[t * 3], MO_FIFO_CACHE_SIZE);
+            running_triangles++;
+
+            if(t + 1 < end && (float)running_misses / (float)running_triangles <= cluster_threshold) {
+                clusters[cluster_count++].mEnd = t + 1;
+                clusters[cluster_count].mStart = t + 1;
+
+                running_misses = running_triangles = 0;
+                time += MO_FIFO_CACHE_SIZE + 1;
+            }
+        }
+
+        clusters[cluster_count++].mEnd = end;
+    }
+
+    float mesh_center[3] = {0.0f, 0.0f, 0.0f};
+    float mesh_area = 0.0f;
+
+    float* cluster_data = (float*)MECCalloc(cluster_count * 7, sizeof(float));
+
+    for(size_t c = 0; c < cluster_count; c++) {
+        float* data = &cluster_data[c * 7];
+
+        for(size_t t = clusters[c].mStart; t < clusters[c].mEnd; t++) {
+            const float* a = &vertices[indices[t * 3 + 0] * 3];
+            const float* b = &vertices[indices[t * 3 + 1] * 3];
+            const float* d = &vertices[indices[t * 3 + 2] * 3];
+
+            float e0[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+            float e1[3] = {d[0] - a[0], d[1] - a[1], d[2] - a[2]};
+            float normal[3] = {e0[1] * e1[2] - e0[2] * e1[1], e0[2] * e1[0] - e0[0] * e1[2], e0[0] * e1[1] - e0[1] * e1[0]};
+            float area = sqrtf(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+
+            for(uint32_t k = 0; k < 3; k++) {
+                float center = (a[k] + b[k] + d[k]) / 3.0f;
+
+                data[k] += center * area;
+                data[3 + k] += normal[k];
+                mesh_center[k] += center * area;
+            }
+
+            data[6] += area;
+            mesh_area += area;
+        }
+    }
+
+    for(uint32_t k = 0; k < 3; k++) {
+        mesh_center[k] = mesh_area > 0.0f ? mesh_center[k] / mesh_area : 0.0f;
+    }
+
+    for(size_t c = 0; c < cluster_count; c++) {
+        const float* data = &cluster_data[c * 7];
+        float normal_length = sqrtf(data[3] * data[3] + data[4] * data[4] + data[5] * data[5]);
+        float key = 0.0f;
+
+        if(data[6] > 0.0f && normal_length > 0.0f) {
+            for(uint32_t k = 0; k < 3; k++) {
+                key += (data[k] / data[6] - mesh_center[k]) * data[3 + k] / normal_length;
+            }
+        }
+
+        clusters[c].mSortKey = key;
+    }
+
+    qsort(clusters, cluster_count, sizeof(MOCluster_t), __MOCompareClusters);
+
+    uint32_t* result = (uint32_t*)MECMalloc(sizeof(uint32_t) * triangle_count * 3);
+    size_t written = 0;
+
+    for(size_t c = 0; c < cluster_count; c++) {
+        size_t size = (clusters[c].mEnd - clusters[c].mStart) * 3;
+
+        memcpy(&result[written], &indices[clusters[c].mStart * 3], sizeof(uint32_t) * size);
+        written += size;
+    }
+
+    memcpy(indices, result, sizeof(uint32_t) * written);
+
+    MECFree(result);
+    MECFree(cluster_data);
+    MECFree(clusters);
+    MECFree(hard);
+    MECFree(timestamps);
+}
+
+/**
+ * @brief Moves mesh stream elements to remapped positions
+ *
+ * @param ppStream stream pointer, replaced by reordered stream
+ * @param remap new position of every vertex
+ * @param vertexCount vertices amount
+ * @param capacity stream capacity in vertices
+ * @param components floats per vertex
+ */
+void __MORemapStream(float** ppStream, const uint32_t* remap, size_t vertexCount, size_t capacity, uint32_t components) {
+    float* stream = (float*)MECMalloc(sizeof(float) * capacity * components);
+
+    for(size_t v = 0; v < vertexCount; v++) {
+        memcpy(&stream[remap[v] * components], &(*ppStream)[v * components], sizeof(float) * components);
+    }
+
+    MECFree(*ppStream);
+    *ppStream = stream;
+}
+
+/**
+ * @brief Reorder vertices in order of first use by indices (LOD levels included), so vertex fetch reads memory almost linearly. Unreferenced vertices are moved to end of mesh. Run after triangle reordering
+ *
+ * @param pMesh indexed mesh pointer
+ */
+void MOOptimizeVertexFetch(Mesh_t* pMesh) {
+    if(pMesh->mIndexCount == 0 || pMesh->mMeshSize == 0) {
+        return;
+    }
+
+    uint32_t* remap = (uint32_t*)MECMalloc(sizeof(uint32_t) * pMesh->mMeshSize);
+    memset(remap, 0xff, sizeof(uint32_t) * pMesh->mMeshSize);
+
+    uint32_t next = 0;
+    size_t index_end = MLodIndexEnd(pMesh);
+
+    for(size_t i = 0; i < index_end; i++) {
+        uint32_t* index = &pMesh->mIndices[i];
+
+        if(remap[*index] == UINT32_MAX) {
+            remap[*index] = next++;
+        }
+
+        *index = remap[*index];
+    }
+
+    for(size_t v = 0; v < pMesh->mMeshSize; v++) {
+        if(remap[v] == UINT32_MAX) {
+            remap[v] = next++;
+        }
+    }
+
+    __MORemapStream(&pMesh->mVertices, remap, pMesh->mMeshSize, pMesh->mMeshCapacity, 3);
+    __MORemapStream(&pMesh->mNormals, remap, pMesh->mMeshSize, pMesh->mMeshCapacity, 3);
+    __MORemapStream(&pMesh->mTextureCoordinates, remap, pMesh->mMeshSize, pMesh->mMeshCapacity, 2);
+    __MORemapStream(&pMesh->mColors, remap, pMesh->mMeshSize, pMesh->mMeshCapacity, 4);
+
+    MECFree(remap);
+}
+
+#define MO_WELD_BUCKETS 256
+#define MO_WELD_JOB_VERTICES 65536
+
+/**
+ * @brief Welding tolerance of every vertex attribute, values are quantized to grid of this size before comparison. 0 means only bitwise equal values are welded
+ */
+typedef struct WeldEpsilon_s {
+    float mPosition;
+    float mNormal;
+    float mTextureCoordinates;
+    float mColor;
+} WeldEpsilon_t;
+
+typedef struct MOWeldJob_s {
+    const Mesh_t* mMesh;
+    const WeldEpsilon_t* mEpsilon;
+
+    uint64_t* mHashes;
+    uint32_t* mBuckets;
+    uint32_t* mBucketOffset;
+    uint32_t* mOrder;
+    uint32_t* mRepresentative;
+} MOWeldJob_t;
+
+/**
+ * @brief Quantizes attribute value to weld grid
+ *
+ * @param value
+ * @param epsilon
+ * @return int64_t
+ */
+int64_t __MOWeldQuantize(float value, float epsilon) {
+    if(epsilon > 0.0f) {
+        return (int64_t)floor((double)value / (double)epsilon + 0.5);
+    }
+
+    uint32_t bits;
+    value = value == 0.0f ? 0.0f : value;
+    memcpy(&bits, &value, sizeof(uint32_t));
+
+    return bits;
+}
+
+/**
+ * @brief Quantized attributes of vertex (position, normal, texture coordinates, color)
+ *
+ * @param pMesh mesh pointer
+ * @param pEpsilon weld tolerance
+ * @param vertex vertex index
+ * @param key output key
+ */
+void __MOWeldKey(const Mesh_t* pMesh, const WeldEpsilon_t* pEpsilon, uint32_t vertex, int64_t key[12]) {
+    for(uint32_t c = 0; c < 3; c++) {
+        key[c] = __MOWeldQuantize(pMesh->mVertices[vertex * 3 + c], pEpsilon->mPosition);
+        key[3 + c] = __MOWeldQuantize(pMesh->mNormals[vertex * 3 + c], pEpsilon->mNormal);
+    }
+
+    key[6] = __MOWeldQuantize(pMesh->mTextureCoordinates[vertex * 2 + 0], pEpsilon->mTextureCoordinates);
+    key[7] = __MOWeldQuantize(pMesh->mTextureCoordinates[vertex * 2 + 1], pEpsilon->mTextureCoordinates);
+
+    for(uint32_t c = 0; c < 4; c++) {
+        key[8 + c] = __MOWeldQuantize(pMesh->mColors[vertex * 4 + c], pEpsilon->mColor);
+    }
+}
+
+/**
+ * @brief Hashes keys of vertex range, bucket is chosen by position cell only so welded vertices always share bucket
+ *
+ * @param pJob weld job
+ * @param job vertex range index
+ */
+void __MOWeldHashJob(void* pJob, uint32_t job) {
+    MOWeldJob_t* weld = (MOWeldJob_t*)pJob;
+    size_t first = (size_t)job * MO_WELD_JOB_VERTICES;
+    size_t last = first + MO_WELD_JOB_VERTICES < weld->mMesh->mMeshSize ? first + MO_WELD_JOB_VERTICES : weld->mMesh->mMeshSize;
+
+    for(size_t v = first; v < last; v++) {
+        int64_t key[12];
+        __MOWeldKey(weld->mMesh, weld->mEpsilon, (uint32_t)v, key);
+
+        weld->mHashes[v] = CHashFNV1a((const uint8_t*)key, sizeof(key));
+        weld->mBuckets[v] = (uint32_t)(CHashFNV1a((const uint8_t*)key, sizeof(int64_t) * 3) % MO_WELD_BUCKETS);
+    }
+}
+
+/**
+ * @brief Finds first vertex with same key for every vertex of bucket
+ *
+ * @param pJob weld job
+ * @param bucket bucket index
+ */
+void __MOWeldBucketJob(void* pJob, uint32_t bucket) {
+    MOWeldJob_t* weld = (MOWeldJob_t*)pJob;
+    uint32_t first = weld->mBucketOffset[bucket];
+    uint32_t count = weld->mBucketOffset[bucket + 1] - first;
+
+    if(count == 0) {
+        return;
+    }
+
+    uint32_t table_size = 1;
+
+    while(table_size < count * 2) {
+        table_size <<= 1;
+    }
+
+    uint32_t* table = (uint32_t*)MECMalloc(sizeof(uint32_t) * table_size);
+    memset(table, 0xff, sizeof(uint32_t) * table_size);
+
+    // bucket keeps vertices in original order, so representative is always first occurrence
+    for(uint32_t i = 0; i < count; i++) {
+        uint32_t vertex = weld->mOrder[first + i];
+        uint32_t slot = (uint32_t)weld->mHashes[vertex] & (table_size - 1);
+
+        weld->mRepresentative[vertex] = vertex;
+
+        while(table[slot] != UINT32_MAX) {
+            uint32_t other = table[slot];
+
+            if(weld->mHashes[other] == weld->mHashes[vertex]) {
+                int64_t key[12], other_key[12];
+
+                __MOWeldKey(weld->mMesh, weld->mEpsilon, vertex, key);
+                __MOWeldKey(weld->mMesh, weld->mEpsilon, other, other_key);
+
+                if(memcmp(key, other_key, sizeof(key)) == 0) {
+                    weld->mRepresentative[vertex] = other;
+
+                    break;
+                }
+            }
+
+            slot = (slot + 1) & (table_size - 1);
+        }
+
+        if(weld->mRepresentative[vertex] == vertex) {
+            table[slot] = vertex;
+        }
+    }
+
+    MECFree(table);
+}
+
+/**
+ * @brief Weld vertices with equal (position, normal, texture coordinates, color) after quantization to pEpsilon, mesh becomes indexed mesh with unique vertices. Works on indexed meshes and meshes with duplicated corners, buckets of close vertices are welded in parallel
+ *
+ * @param pMesh mesh pointer
+ * @param pEpsilon weld tolerance
+ * @return size_t amount of removed vertices
+ */
+size_t MOWeldMesh(Mesh_t* pMesh, const WeldEpsilon_t* pEpsilon) {
+    size_t vertex_count = pMesh->mMeshSize;
+
+    if(vertex_count == 0) {
+        return 0;
+    }
+
+    if(vertex_count > UINT32_MAX - 1) {
+        E_WARN("Mesh has too many vertices for 32 bit indices, it is not welded!");
+
+        return 0;
+    }
+
+    MOWeldJob_t weld;
+    weld.mMesh = pMesh;
+    weld.mEpsilon = pEpsilon;
+    weld.mHashes = (uint64_t*)MECMalloc(sizeof(uint64_t) * vertex_count);
+    weld.mBuckets = (uint32_t*)MECMalloc(sizeof(uint32_t) * vertex_count);
+    weld.mBucketOffset = (uint32_t*)MECCalloc(MO_WELD_BUCKETS + 1, sizeof(uint32_t));
+    weld.mOrder = (uint32_t*)MECMalloc(sizeof(uint32_t) * vertex_count);
+    weld.mRepresentative = (uint32_t*)MECMalloc(sizeof(uint32_t) * vertex_count);
+
+    MTParallelFor((uint32_t)((vertex_count + MO_WELD_JOB_VERTICES - 1) / MO_WELD_JOB_VERTICES), __MOWeldHashJob, &weld);
+
+    for(size_t v = 0; v < vertex_count; v++) {
+        weld.mBucketOffset[weld.mBuckets[v] + 1]++;
+    }
+
+    for(uint32_t b = 0; b < MO_WELD_BUCKETS; b++) {
+        weld.mBucketOffset[b + 1] += weld.mBucketOffset[b];
+    }
+
+    uint32_t cursor[MO_WELD_BUCKETS];
+    memcpy(cursor, weld.mBucketOffset, sizeof(cursor));
+
+    for(size_t v = 0; v < vertex_count; v++) {
+        weld.mOrder[cursor[weld.mBuckets[v]]++] = (uint32_t)v;
+    }
+
+    MTParallelFor(MO_WELD_BUCKETS, __MOWeldBucketJob, &weld);
+
+    // representative is first occurrence, so it has its new index before any welded vertex
+    uint32_t* remap = weld.mOrder;
+    uint32_t unique = 0;
+
+    for(size_t v = 0; v < vertex_count; v++) {
+        remap[v] = weld.mRepresentative[v] == v ? unique++ : remap[weld.mRepresentative[v]];
+    }
+
+    if(pMesh->mIndexCount == 0) {
+        MAllocIndices(pMesh, vertex_count);
+
+        for(size_t i = 0; i < vertex_count; i++) {
+            pMesh->mIndices[i] = remap[i];
+        }
+    }
+    else {
+        size_t index_end = MLodIndexEnd(pMesh);
+
+        for(size_t i = 0; i < index_end; i++) {
+            pMesh->mIndices[i] = remap[pMesh->mIndices[i]];
+        }
+    }
+
+    for(size_t v = 0; v < vertex_count; v++) {
+        if(weld.mRepresentative[v] != v || remap[v] == v) {
+            continue;
+        }
+
+        memcpy(&pMesh->mVertices[remap[v] * 3], &pMesh->mVertices[v * 3], sizeof(float) * 3);
+        memcpy(&pMesh->mNormals[remap[v] * 3], &pMesh->mNormals[v * 3], sizeof(float) * 3);
+        memcpy(&pMesh->mTextureCoordinates[remap[v] * 2], &pMesh->mTextureCoordinates[v * 2], sizeof(float) * 2);
+        memcpy(&pMesh->mColors[remap[v] * 4], &pMesh->mColors[v * 4], sizeof(float) * 4);
+    }
+
+    pMesh->mMeshSize = unique;
+    MCalculateBounds(pMesh);
+
+    MECFree(weld.mRepresentative);
+    MECFree(weld.mOrder);
+    MECFree(weld.mBucketOffset);
+    MECFree(weld.mBuckets);
+    MECFree(weld.mHashes);
+
+    return vertex_count - unique;
+}
+
+#define MO_LOD_LEVELS 5
+#define MO_LOD_RATIO 0.5f
+#define MO_LOD_MIN_REDUCTION 0.95f
+#define MO_QUADRIC_SIZE 11
+#define MO_VERTEX_LOCKED 1
+#define MO_VERTEX_TOUCHED 2
+
+typedef struct MOCollapse_s {
+    float mCost;
+    uint32_t mFrom;
+    uint32_t mTo;
+} MOCollapse_t;
+
+/**
+ * @brief Adds area weighted plane quadric of triangle to its vertices. Quadric is symmetric 4x4 matrix (10 values) followed by total weight
+ *
+ * @param quadrics vertex quadrics
+ * @param vertices vertex positions
+ * @param triangle triangle indices
+ */
+void __MOAddTriangleQuadric(double* quadrics, const float* vertices, const uint32_t* triangle) {
+    const float* p0 = &vertices[triangle[0] * 3];
+    const float* p1 = &vertices[triangle[1] * 3];
+    const float* p2 = &vertices[triangle[2] * 3];
+
+    double e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+    double e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+    double n[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+    double length = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+
+    if(length == 0.0) {
+        return;
+    }
+
+    double a = n[0] / length, b = n[1] / length, c = n[2] / length;
+    double d = -(a * p0[0] + b * p0[1] + c * p0[2]);
+    double weight = length * 0.5;
+    const double quadric[MO_QUADRIC_SIZE] = { a * a, a * b, a * c, a * d, b * b, b * c, b * d, c * c, c * d, d * d, 1.0 };
+
+    for(uint32_t v = 0; v < 3; v++) {
+        for(uint32_t i = 0; i < MO_QUADRIC_SIZE; i++) {
+            quadrics[triangle[v] * MO_QUADRIC_SIZE + i] += quadric[i] * weight;
+        }
+    }
+}
+
+/**
+ * @brief Mean squared distance of point to planes of two summed quadrics
+ *
+ * @param qa first quadric
+ * @param qb second quadric
+ * @param p point
+ * @return float
+ */
+float __MOQuadricError(const double* qa, const double* qb, const float* p) {
+    double q[MO_QUADRIC_SIZE];
+
+    for(uint32_t i = 0; i < MO_QUADRIC_SIZE; i++) {
+        q[i] = qa[i] + qb[i];
+    }
+
+    double x = p[0], y = p[1], z = p[2];
+    double error = q[0] * x * x + 2.0 * q[1] * x * y + 2.0 * q[2] * x * z + 2.0 * q[3] * x
+                 + q[4] * y * y + 2.0 * q[5] * y * z + 2.0 * q[6] * y
+                 + q[7] * z * z + 2.0 * q[8] * z + q[9];
+
+    return q[10] > 0.0 ? (float)(fabs(error) / q[10]) : 0.0f;
+}
+
+int __MOCompareCollapses(const void* pA, const void* pB) {
+    float a = ((const MOCollapse_t*)pA)->mCost, b = ((const MOCollapse_t*)pB)->mCost;
+
+    return (a > b) - (a < b);
+}
+
+/**
+ * @brief Checks that moving vertex onto other vertex flips none of its remaining triangles
+ *
+ * @param indices triangles
+ * @param adjacencyOffsets first adjacent triangle of every vertex
+ * @param adjacency adjacent triangles
+ * @param vertices vertex positions
+ * @param from collapsed vertex
+ * @param to target vertex
+ * @return true when collapse keeps triangle orientation
+ */
+bool __MOCollapseValid(const uint32_t* indices, const uint32_t* adjacencyOffsets, const uint32_t* adjacency, const float* vertices, uint32_t from, uint32_t to) {
+    for(uint32_t a = adjacencyOffsets[from]; a < adjacencyOffsets[from + 1]; a++) {
+        const uint32_t* triangle = &indices[adjacency[a] * 3];
+
+        if(triangle[0] == to || triangle[1] == to || triangle[2] == to) {
+            continue;
+        }
+
+        float before[3][3], after[3][3];
+
+        for(uint32_t v = 0; v < 3; v++) {
+            memcpy(before[v], &vertices[triangle[v] * 3], sizeof(float) * 3);
+            memcpy(after[v], &vertices[(triangle[v] == from ? to : triangle[v]) * 3], sizeof(float) * 3);
+        }
+
+        float n[2][3];
+
+        for(uint32_t t = 0; t < 2; t++) {
+            float (*p)[3] = t == 0 ? before : after;
+            float e1[3] = { p[1][0] - p[0][0], p[1][1] - p[0][1], p[1][2] - p[0][2] };
+            float e2[3] = { p[2][0] - p[0][0], p[2][1] - p[0][1], p[2][2] - p[0][2] };
+
+            n[t][0] = e1[1] * e2[2] - e1[2] * e2[1];
+            n[t][1] = e1[2] * e2[0] - e1[0] * e2[2];
+            n[t][2] = e1[0] * e2[1] - e1[1] * e2[0];
+        }
+
+        if(n[0][0] * n[1][0] + n[0][1] * n[1][1] + n[0][2] * n[1][2] <= 0.0f) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Simplify triangle list by quadric error metric edge collapses onto existing vertices, so simplified indices keep using same vertex buffer. Vertices on open borders and attribute seams are locked
+ *
+ * @param dst output indices (indexCount capacity, may be same as indices)
+ * @param indices triangle list
+ * @param indexCount indices amount
+ * @param vertices vertex positions
+ * @param vertexCount vertices amount
+ * @param targetIndexCount wanted indices amount, simplification stops earlier when no valid collapse is left
+ * @param pError output object space error of simplified surface
+ * @return size_t amount of indices written to dst
+ */
+size_t MOSimplify(uint32_t* dst, const uint32_t* indices, size_t indexCount, const float* vertices, size_t vertexCount, size_t targetIndexCount, float* pError) {
+    memmove(dst, indices, sizeof(uint32_t) * indexCount);
+    *pError = 0.0f;
+
+    if(indexCount <= targetIndexCount || vertexCount == 0) {
+        return indexCount;
+    }
+
+    double* quadrics = (double*)MECCalloc(vertexCount * MO_QUADRIC_SIZE, sizeof(double));
+    uint8_t* state = (uint8_t*)MECCalloc(vertexCount, sizeof(uint8_t));
+    uint32_t* offsets = (uint32_t*)MECMalloc(sizeof(uint32_t) * (vertexCount + 1));
+    uint32_t* cursor = (uint32_t*)MECMalloc(sizeof(uint32_t) * vertexCount);
+    uint32_t* adjacency = (uint32_t*)MECMalloc(sizeof(uint32_t) * indexCount);
+    uint32_t* remap = (uint32_t*)MECMalloc(sizeof(uint32_t) * vertexCount);
+    MOCollapse_t* collapses = (MOCollapse_t*)MECMalloc(sizeof(MOCollapse_t) * indexCount * 2);
+    size_t count = indexCount;
+    float max_error = 0.0f;
+
+    for(size_t i = 0; i < count; i += 3) {
+        __MOAddTriangleQuadric(quadrics, vertices, &dst[i]);
+    }
+
+    for(size_t v = 0; v < vertexCount; v++) {
+        remap[v] = (uint32_t)v;
+    }
+
+    // border edge has no opposite half edge, its vertices are locked so open borders and seams keep their shape
+    memset(offsets, 0, sizeof(uint32_t) * (vertexCount + 1));
+
+    for(size_t i = 0; i < count; i++) {
+        offsets[dst[i] + 1]++;
+    }
+
+    for(size_t v = 0; v < vertexCount; v++) {
+        offsets[v + 1] += offsets[v];
+    }
+
+    memcpy(cursor, offsets, sizeof(uint32_t) * vertexCount);
+
+    for(size_t i = 0; i < count; i++) {
+        adjacency[cursor[dst[i]]++] = dst[i - i % 3 + (i + 1) % 3];
+    }
+
+    for(size_t i = 0; i < count; i++) {
+        uint32_t a = dst[i], b = dst[i - i % 3 + (i + 1) % 3];
+        bool opposite = false;
+
+        for(uint32_t e = offsets[b]; e < offsets[b + 1] && !opposite; e++) {
+            opposite = adjacency[e] == a;
+        }
+
+        if(!opposite) {
+            state[a] |= MO_VERTEX_LOCKED;
+            state[b] |= MO_VERTEX_LOCKED;
+        }
+    }
+
+    while(count > targetIndexCount) {
+        memset(offsets, 0, sizeof(uint32_t) * (vertexCount + 1));
+
+        for(size_t i = 0; i < count; i++) {
+            offsets[dst[i] + 1]++;
+        }
+
+        for(size_t v = 0; v < vertexCount; v++) {
+            offsets[v + 1] += offsets[v];
+            state[v] &= (uint8_t)~MO_VERTEX_TOUCHED;
+        }
+
+        memcpy(cursor, offsets, sizeof(uint32_t) * vertexCount);
+
+        for(size_t i = 0; i < count; i++) {
+            adjacency[cursor[dst[i]]++] = (uint32_t)(i / 3);
+        }
+
+        size_t collapse_count = 0;
+
+        for(size_t i = 0; i < count; i++) {
+            uint32_t a = dst[i], b = dst[i - i % 3 + (i + 1) % 3];
+
+            if(!(state[a] & MO_VERTEX_LOCKED)) {
+                collapses[collapse_count++] = (MOCollapse_t){ __MOQuadricError(&quadrics[a * MO_QUADRIC_SIZE], &quadrics[b * MO_QUADRIC_SIZE], &vertices[b * 3]), a, b };
+            }
+
+            if(!(state[b] & MO_VERTEX_LOCKED)) {
+                collapses[collapse_count++] = (MOCollapse_t){ __MOQuadricError(&quadrics[a * MO_QUADRIC_SIZE], &quadrics[b * MO_QUADRIC_SIZE], &vertices[a * 3]), b, a };
+            }
+        }
+
+        qsort(collapses, collapse_count, sizeof(MOCollapse_t), __MOCompareCollapses);
+
+        // collapses of one pass don`t share triangles, so each is validated against unchanged neighbourhood
+        size_t triangles = count / 3;
+        size_t collapsed = 0;
+
+        for(size_t c = 0; c < collapse_count && triangles > targetIndexCount / 3; c++) {
+            uint32_t from = collapses[c].mFrom, to = collapses[c].mTo;
+
+            if((state[from] | state[to]) & MO_VERTEX_TOUCHED || !__MOCollapseValid(dst, offsets, adjacency, vertices, from, to)) {
+                continue;
+            }
+
+            for(uint32_t v = 0; v < 2; v++) {
+                uint32_t vertex = v == 0 ? from : to;
+
+                for(uint32_t a = offsets[vertex]; a < offsets[vertex + 1]; a++) {
+                    const uint32_t* triangle = &dst[adjacency[a] * 3];
+
+                    state[triangle[0]] |= MO_VERTEX_TOUCHED;
+                    state[triangle[1]] |= MO_VERTEX_TOUCHED;
+                    state[triangle[2]] |= MO_VERTEX_TOUCHED;
+
+                    triangles -= v == 0 && (triangle[0] == to || triangle[1] == to || triangle[2] == to);
+                }
+            }
+
+            for(uint32_t i = 0; i < MO_QUADRIC_SIZE; i++) {
+                quadrics[to * MO_QUADRIC_SIZE + i] += quadrics[from * MO_QUADRIC_SIZE + i];
+            }
+
+            remap[from] = to;
+            max_error = collapses[c].mCost > max_error ? collapses[c].mCost : max_error;
+            collapsed++;
+        }
+
+        if(collapsed == 0) {
+            break;
+        }
+
+        size_t write = 0;
+
+        for(size_t i = 0; i < count; i += 3) {
+            uint32_t a = remap[dst[i + 0]], b = remap[dst[i + 1]], c = remap[dst[i + 2]];
+
+            if(a != b && b != c && a != c) {
+                dst[write++] = a;
+                dst[write++] = b;
+                dst[write++] = c;
+            }
+        }
+
+        count = write;
+    }
+
+    *pError = sqrtf(max_error);
+
+    MECFree(collapses);
+    MECFree(remap);
+    MECFree(adjacency);
+    MECFree(cursor);
+    MECFree(offsets);
+    MECFree(state);
+    MECFree(quadrics);
+
+    return count;
+}
+
+/**
+ * @brief Generate LOD chain of indexed mesh, each level is simplified (MOSimplify) from previous one to ratio of its triangles and stored right after it in mesh index buffer. Chain ends early when level can`t be reduced any more
+ *
+ * @param pMesh indexed mesh pointer
+ * @param levelCount wanted amount of levels including full mesh (up to M_MAX_LODS)
+ * @param ratio triangle ratio between following levels
+ */
+void MOGenerateLods(Mesh_t* pMesh, uint32_t levelCount, float ratio) {
+    if(pMesh->mIndexCount == 0) {
+        E_WARN("LOD generation needs indexed mesh, mesh is left as is!");
+
+        return;
+    }
+
+    levelCount = levelCount > M_MAX_LODS ? M_MAX_LODS : levelCount;
+
+    pMesh->mLods[0] = (MeshLod_t){ 0, pMesh->mIndexCount, 0.0f };
+    pMesh->mLodCount = 1;
+
+    uint32_t* level = (uint32_t*)MECMalloc(sizeof(uint32_t) * pMesh->mIndexCount);
+
+    for(uint32_t l = 1; l < levelCount; l++) {
+        MeshLod_t previous = pMesh->mLods[l - 1];
+        size_t target = (size_t)((float)(previous.mIndexCount / 3) * ratio) * 3;
+        float error = 0.0f;
+
+        if(target < 3) {
+            break;
+        }
+
+        size_t count = MOSimplify(level, &pMesh->mIndices[previous.mIndexOffset], previous.mIndexCount, pMesh->mVertices, pMesh->mMeshSize, target, &error);
+
+        if(count == 0 || (float)count > (float)previous.mIndexCount * MO_LOD_MIN_REDUCTION) {
+            break;
+        }
+
+        size_t offset = previous.mIndexOffset + previous.mIndexCount;
+
+        MReserveIndices(pMesh, offset + count);
+        memcpy(&pMesh->mIndices[offset], level, sizeof(uint32_t) * count);
+
+        pMesh->mLods[l] = (MeshLod_t){ offset, count, error > previous.mError ? error : previous.mError };
+        pMesh->mLodCount++;
+    }
+
+    MECFree(level);
+}
+
+#define MO_MESHLET_VERTICES 64
+#define MO_MESHLET_TRIANGLES 124
+
+/**
+ * @brief Bounding sphere and normal cone of meshlet triangles
+ *
+ * @param pMesh mesh pointer
+ * @param pMeshlet meshlet with filled index range
+ */
+void __MOMeshletBounds(const Mesh_t* pMesh, Meshlet_t* pMeshlet) {
+    const uint32_t* indices = &pMesh->mIndices[pMeshlet->mIndexOffset];
+    float bounds_min[3], bounds_max[3];
+    float axis[3] = { 0.0f, 0.0f, 0.0f };
+
+    memcpy(bounds_min, &pMesh->mVertices[indices[0] * 3], sizeof(bounds_min));
+    memcpy(bounds_max, &pMesh->mVertices[indices[0] * 3], sizeof(bounds_max));
+
+    for(uint32_t i = 0; i < pMeshlet->mIndexCount; i++) {
+        for(uint32_t c = 0; c < 3; c++) {
+            float value = pMesh->mVertices[indices[i] * 3 + c];
+
+            bounds_min[c] = value < bounds_min[c] ? value : bounds_min[c];
+            bounds_max[c] = value > bounds_max[c] ? value : bounds_max[c];
+        }
+    }
+
+    pMeshlet->mRadius = 0.0f;
+
+    for(uint32_t c = 0; c < 3; c++) {
+        pMeshlet->mCenter[c] = (bounds_min[c] + bounds_max[c]) * 0.5f;
+    }
+
+    for(uint32_t i = 0; i < pMeshlet->mIndexCount; i++) {
+        const float* p = &pMesh->mVertices[indices[i] * 3];
+        float d[3] = { p[0] - pMeshlet->mCenter[0], p[1] - pMeshlet->mCenter[1], p[2] - pMeshlet->mCenter[2] };
+        float distance = sqrtf(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+
+        pMeshlet->mRadius = distance > pMeshlet->mRadius ? distance : pMeshlet->mRadius;
+    }
+
+    // triangle normals of whole meshlet have to fit into cone around their average
+    float normals[MO_MESHLET_TRIANGLES][3];
+    uint32_t normal_count = 0;
+
+    for(uint32_t i = 0; i < pMeshlet->mIndexCount; i += 3) {
+        const float* p0 = &pMesh->mVertices[indices[i + 0] * 3];
+        const float* p1 = &pMesh->mVertices[indices[i + 1] * 3];
+        const float* p2 = &pMesh->mVertices[indices[i + 2] * 3];
+        float e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+        float e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+        float n[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+        float length = sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+
+        if(length == 0.0f) {
+            continue;
+        }
+
+        for(uint32_t c = 0; c < 3; c++) {
+            normals[normal_count][c] = n[c] / length;
+            axis[c] += normals[normal_count][c];
+        }
+
+        normal_count++;
+    }
+
+    float axis_length = sqrtf(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+    float min_dot = 1.0f;
+
+    for(uint32_t i = 0; i < normal_count && axis_length > 0.0f; i++) {
+        float dot = (normals[i][0] * axis[0] + normals[i][1] * axis[1] + normals[i][2] * axis[2]) / axis_length;
+
+        min_dot = dot < min_dot ? dot : min_dot;
+    }
+
+    if(axis_length == 0.0f || min_dot <= 0.0f) {
+        memset(pMeshlet->mConeAxis, 0, sizeof(pMeshlet->mConeAxis));
+        pMeshlet->mConeCutoff = 1.0f;
+
+        return;
+    }
+
+    for(uint32_t c = 0; c < 3; c++) {
+        pMeshlet->mConeAxis[c] = axis[c] / axis_length;
+    }
+
+    pMeshlet->mConeCutoff = sqrtf(1.0f - min_dot * min_dot);
+}
+
+/**
+ * @brief Split full mesh triangles into meshlets of up to MO_MESHLET_TRIANGLES triangles and MO_MESHLET_VERTICES vertices. Triangles are taken in their order, so run after MOOptimizeMesh (vertex cache order keeps meshlets compact) and meshlets stay index ranges of mesh
+ *
+ * @param pMesh indexed mesh pointer
+ * @return uint32_t amount of meshlets
+ */
+uint32_t MOBuildMeshlets(Mesh_t* pMesh) {
+    if(pMesh->mIndexCount < 3) {
+        E_WARN("Meshlets need indexed mesh, mesh is left as is!");
+
+        return 0;
+    }
+
+    size_t triangle_count = pMesh->mIndexCount / 3;
+    uint32_t* stamps = (uint32_t*)MECMalloc(sizeof(uint32_t) * pMesh->mMeshSize);
+    uint32_t meshlet_count = 0, vertex_count = 0;
+    size_t start = 0;
+
+    memset(stamps, 0xff, sizeof(uint32_t) * pMesh->mMeshSize);
+    pMesh->mMeshlets = MECRealloc(pMesh->mMeshlets, sizeof(Meshlet_t) * triangle_count);
+
+    for(size_t t = 0; t <= triangle_count; t++) {
+        const uint32_t* triangle = &pMesh->mIndices[t * 3];
+        uint32_t new_vertices = 0;
+
+        for(uint32_t v = 0; v < 3 && t < triangle_count; v++) {
+            new_vertices += stamps[triangle[v]] != meshlet_count && (v == 0 || triangle[v] != triangle[0]) && (v < 2 || triangle[v] != triangle[1]);
+        }
+
+        if(t == triangle_count || t - start == MO_MESHLET_TRIANGLES || vertex_count + new_vertices > MO_MESHLET_VERTICES) {
+            Meshlet_t* meshlet = &pMesh->mMeshlets[meshlet_count++];
+
+            meshlet->mIndexOffset = (uint32_t)(start * 3);
+            meshlet->mIndexCount = (uint32_t)((t - start) * 3);
+            __MOMeshletBounds(pMesh, meshlet);
+
+            start = t;
+            vertex_count = 0;
+            new_vertices = 3;
+        }
+
+        for(uint32_t v = 0; v < 3 && t < triangle_count; v++) {
+            stamps[triangle[v]] = meshlet_count;
+        }
+
+        vertex_count += new_vertices;
+    }
+
+    pMesh->mMeshlets = MECRealloc(pMesh->mMeshlets, sizeof(Meshlet_t) * meshlet_count);
+    pMesh->mMeshletCount = meshlet_count;
+
+    MECFree(stamps);
+
+    return meshlet_count;
+}
+
+/**
+ * @brief Run whole post load optimization on indexed mesh: vertex cache triangle order, overdraw cluster order and vertex fetch order. Rendered result is same, only order of triangles and vertices changes. LOD levels get vertex cache order too, meshlets are dropped (build them afterwards)
+ *
+ * @param pMesh indexed mesh pointer (e.g. from MLoadPLYIndexedMeshFromFile)
+ */
+void MOOptimizeMesh(Mesh_t* pMesh) {
+    if(pMesh->mIndexCount == 0) {
+        E_WARN("Mesh optimization needs indexed mesh, mesh is left as is!");
+
+        return;
+    }
+
+    pMesh->mMeshletCount = 0;
+
+    MOOptimizeVertexCache(pMesh->mIndices, pMesh->mIndexCount, pMesh->mMeshSize);
+    MOOptimizeOverdraw(pMesh->mIndices, pMesh->mIndexCount, pMesh->mVertices, pMesh->mMeshSize, MO_OVERDRAW_THRESHOLD);
+
+    for(uint32_t l = 1; l < pMesh->mLodCount; l++) {
+        MOOptimizeVertexCache(&pMesh->mIndices[pMesh->mLods[l].mIndexOffset], pMesh->mLods[l].mIndexCount, pMesh->mMeshSize);
+    }
+
+    MOOptimizeVertexFetch(pMesh);
+}
+
+/**
+ * @brief Cook indexed mesh for rendering: exact weld, MO_LOD_LEVELS LOD chain, MOOptimizeMesh and meshlets. Loaders never call it, geometry stays as in file unless it is cooked explicitly (e.g. MLoadPLYMeshCached with cook)
+ *
+ * @param pMesh indexed mesh pointer
+ */
+void MOCookMesh(Mesh_t* pMesh) {
+    if(pMesh->mIndexCount == 0) {
+        E_WARN("Mesh cooking needs indexed mesh, mesh is left as is!");
+
+        return;
+    }
+
+    WeldEpsilon_t exact = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+    MOWeldMesh(pMesh, &exact);
+    MOGenerateLods(pMesh, MO_LOD_LEVELS, MO_LOD_RATIO);
+    MOOptimizeMesh(pMesh);
+    MOBuildMeshlets(pMesh);
+}
+
+#endif
@@ -2,7 +2,384 @@
 #define _EFFECTIVE_MULTITHREADER_
 
 #include <stdlib.h>
+#include <stdint.h>
+#include <stdatomic.h>
 #include <pthread.h>
 #include <semaphore.h>
+#include <time.h>
 
-#endif
\ No newline at end of file
+#include "core.h"
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+#define MT_MAX_THREADS 64
+
+typedef void (*PFN_MTJobFunction)(void* pArgs, uint32_t job);
+
+uint32_t gMTThreadCount = 0;
+
+/**
+ * @brief Set amount of threads used by MTParallelFor and task pool started afterwards, 0 means amount of online cores
+ *
+ * @param count
+ */
+void MTSetThreadCount(uint32_t count) {
+    gMTThreadCount = count > MT_MAX_THREADS ? MT_MAX_THREADS : count;
+}
+
+/**
+ * @brief Get amount of threads used by MTParallelFor
+ *
+ * @return uint32_t
+ */
+uint32_t MTGetThreadCount() {
+    if(gMTThreadCount != 0) {
+        return gMTThreadCount;
+    }
+
+#ifdef _WIN32
+    SYSTEM_INFO system_info;
+    GetSystemInfo(&system_info);
+    long cores = (long)system_info.dwNumberOfProcessors;
+#else
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+
+    return cores < 1 ? 1 : (cores > MT_MAX_THREADS ? MT_MAX_THREADS : (uint32_t)cores);
+}
+
+typedef void (*PFN_MTTaskFunction)(void* pArgs);
+
+typedef struct MTTask_s {
+    PFN_MTTaskFunction mFn;
+    void* mArgs;
+    struct MTTask_s* mNext;
+} MTTask_t;
+
+typedef struct MTTaskQueue_s {
+    MTTask_t* mHead;
+    MTTask_t* mTail;
+    pthread_mutex_t mMutex;
+    pthread_cond_t mCondition;
+} MTTaskQueue_t;
+
+typedef struct MTPool_s {
+    MTTaskQueue_t mQueue;
+    pthread_t mThreads[MT_MAX_THREADS];
+    uint32_t mThreadCount;
+    bool mRunning;
+    // workers drain queue and exit, pool stays running so tasks can still submit
+    bool mStopping;
+} MTPool_t;
+
+MTPool_t gMTPool = { { nullptr, nullptr, PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER }, {0}, 0, false, false };
+MTTaskQueue_t gMTMainQueue = { nullptr, nullptr, PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER };
+
+/**
+ * @brief Appends task to queue and wakes one waiting thread
+ *
+ * @param pQueue task queue
+ * @param fn task function
+ * @param pArgs task function arguments
+ */
+void __MTQueuePush(MTTaskQueue_t* pQueue, PFN_MTTaskFunction fn, void* pArgs) {
+    MTTask_t* task = (MTTask_t*)MECMalloc(sizeof(MTTask_t));
+    task->mFn = fn;
+    task->mArgs = pArgs;
+    task->mNext = nullptr;
+
+    pthread_mutex_lock(&pQueue->mMutex);
+
+    if(pQueue->mTail != nullptr) {
+        pQueue->mTail->mNext = task;
+    }
+    else {
+        pQueue->mHead = task;
+    }
+
+    pQueue->mTail = task;
+
+    pthread_cond_signal(&pQueue->mCondition);
+    pthread_mutex_unlock(&pQueue->mMutex);
+}
+
+/**
+ * @brief Takes first task from queue, queue mutex has to be locked
+ *
+ * @param pQueue task queue
+ * @return MTTask_t* task or nullptr when queue is empty
+ */
+MTTask_t* __MTQueuePop(MTTaskQueue_t* pQueue) {
+    MTTask_t* task = pQueue->mHead;
+
+    if(task != nullptr) {
+        pQueue->mHead = task->mNext;
+
+        if(pQueue->mHead == nullptr) {
+            pQueue->mTail = nullptr;
+        }
+    }
+
+    return task;
+}
+
+/**
+ * @brief Worker loop of task pool
+ *
+ * @param pPool
+ * @return void*
+ */
+void* __MTPoolWorker(void* pPool) {
+    MTPool_t* pool = (MTPool_t*)pPool;
+
+    pthread_mutex_lock(&pool->mQueue.mMutex);
+
+    for(;;) {
+        while(!pool->mStopping && pool->mQueue.mHead == nullptr) {
+            pthread_cond_wait(&pool->mQueue.mCondition, &pool->mQueue.mMutex);
+        }
+
+        if(pool->mQueue.mHead == nullptr) {
+            break;
+        }
+
+        MTTask_t* task = __MTQueuePop(&pool->mQueue);
+
+        pthread_mutex_unlock(&pool->mQueue.mMutex);
+
+        task->mFn(task->mArgs);
+        MECFree(task);
+
+        pthread_mutex_lock(&pool->mQueue.mMutex);
+    }
+
+    pthread_mutex_unlock(&pool->mQueue.mMutex);
+
+    return nullptr;
+}
+
+/**
+ * @brief Start background task pool, started pool is left as is
+ *
+ * @param threadCount amount of worker threads, 0 means MTGetThreadCount()
+ */
+void MTPoolStart(uint32_t threadCount) {
+    if(gMTPool.mRunning) {
+        return;
+    }
+
+    threadCount = threadCount == 0 ? MTGetThreadCount() : (threadCount > MT_MAX_THREADS ? MT_MAX_THREADS : threadCount);
+
+    gMTPool.mRunning = true;
+    gMTPool.mThreadCount = 0;
+
+    for(uint32_t i = 0; i < threadCount; i++) {
+        if(pthread_create(&gMTPool.mThreads[gMTPool.mThreadCount], nullptr, __MTPoolWorker, &gMTPool) != 0) {
+            E_WARN("Cannot create task pool thread!");
+
+            break;
+        }
+
+        gMTPool.mThreadCount++;
+    }
+}
+
+/**
+ * @brief Stop background task pool. Every queued task is run before workers exit (tasks own their arguments, e.g. parallel for helpers and asset requests), tasks queued meanwhile are run too
+ */
+void MTPoolStop() {
+    if(!gMTPool.mRunning) {
+        return;
+    }
+
+    pthread_mutex_lock(&gMTPool.mQueue.mMutex);
+    gMTPool.mStopping = true;
+    pthread_cond_broadcast(&gMTPool.mQueue.mCondition);
+    pthread_mutex_unlock(&gMTPool.mQueue.mMutex);
+
+    for(uint32_t i = 0; i < gMTPool.mThreadCount; i++) {
+        pthread_join(gMTPool.mThreads[i], nullptr);
+    }
+
+    // tasks queued after last worker exited (or with no worker at all) are run here
+    for(;;) {
+        pthread_mutex_lock(&gMTPool.mQueue.mMutex);
+        MTTask_t* task = __MTQueuePop(&gMTPool.mQueue);
+
+        if(task == nullptr) {
+            gMTPool.mRunning = false;
+            gMTPool.mStopping = false;
+            gMTPool.mThreadCount = 0;
+        }
+
+        pthread_mutex_unlock(&gMTPool.mQueue.mMutex);
+
+        if(task == nullptr) {
+            break;
+        }
+
+        task->mFn(task->mArgs);
+        MECFree(task);
+    }
+}
+
+/**
+ * @brief Run fn(pArgs) on background task pool, pool is started when it is not running yet
+ *
+ * @param fn task function
+ * @param pArgs task function arguments
+ */
+void MTSubmit(PFN_MTTaskFunction fn, void* pArgs) {
+    MTPoolStart(0);
+
+    __MTQueuePush(&gMTPool.mQueue, fn, pArgs);
+}
+
+typedef struct MTJobs_s {
+    PFN_MTJobFunction mFn;
+    void* mArgs;
+    uint32_t mJobCount;
+    atomic_uint mNextJob;
+    atomic_uint mDoneJobs;
+    // calling thread and helper tasks that still hold jobs, last one frees them
+    atomic_uint mReferences;
+    pthread_mutex_t mMutex;
+    pthread_cond_t mCondition;
+} MTJobs_t;
+
+void __MTReleaseJobs(MTJobs_t* pJobs) {
+    if(atomic_fetch_sub(&pJobs->mReferences, 1) == 1) {
+        pthread_mutex_destroy(&pJobs->mMutex);
+        pthread_cond_destroy(&pJobs->mCondition);
+
+        MECFree(pJobs);
+    }
+}
+
+/**
+ * @brief Take jobs of MTParallelFor until none is left, thread finishing last job wakes calling thread
+ *
+ * @param pJobs
+ */
+void __MTRunJobs(MTJobs_t* pJobs) {
+    for(;;) {
+        uint32_t job = atomic_fetch_add(&pJobs->mNextJob, 1);
+
+        if(job >= pJobs->mJobCount) {
+            break;
+        }
+
+        pJobs->mFn(pJobs->mArgs, job);
+
+        if(atomic_fetch_add(&pJobs->mDoneJobs, 1) + 1 == pJobs->mJobCount) {
+            pthread_mutex_lock(&pJobs->mMutex);
+            pthread_cond_broadcast(&pJobs->mCondition);
+            pthread_mutex_unlock(&pJobs->mMutex);
+        }
+    }
+}
+
+void __MTJobsTask(void* pJobs) {
+    __MTRunJobs((MTJobs_t*)pJobs);
+    __MTReleaseJobs((MTJobs_t*)pJobs);
+}
+
+/**
+ * @brief Run fn(pArgs, job) for every job in [0, jobCount) on task pool workers and wait for all of them, calling thread takes jobs too. Waiting is only for jobs, so it can be called from pool tasks as well (helpers that start late find no jobs left)
+ *
+ * @param jobCount amount of jobs
+ * @param fn job function
+ * @param pArgs job function arguments
+ */
+void MTParallelFor(uint32_t jobCount, PFN_MTJobFunction fn, void* pArgs) {
+    uint32_t thread_count = MTGetThreadCount();
+    thread_count = thread_count < jobCount ? thread_count : jobCount;
+
+    if(thread_count <= 1) {
+        for(uint32_t job = 0; job < jobCount; job++) {
+            fn(pArgs, job);
+        }
+
+        return;
+    }
+
+    MTPoolStart(0);
+
+    uint32_t helpers = thread_count - 1 < gMTPool.mThreadCount ? thread_count - 1 : gMTPool.mThreadCount;
+
+    MTJobs_t* jobs = (MTJobs_t*)MECMalloc(sizeof(MTJobs_t));
+    jobs->mFn = fn;
+    jobs->mArgs = pArgs;
+    jobs->mJobCount = jobCount;
+    atomic_init(&jobs->mNextJob, 0);
+    atomic_init(&jobs->mDoneJobs, 0);
+    atomic_init(&jobs->mReferences, helpers + 1);
+    pthread_mutex_init(&jobs->mMutex, nullptr);
+    pthread_cond_init(&jobs->mCondition, nullptr);
+
+    for(uint32_t i = 0; i < helpers; i++) {
+        __MTQueuePush(&gMTPool.mQueue, __MTJobsTask, jobs);
+    }
+
+    __MTRunJobs(jobs);
+
+    pthread_mutex_lock(&jobs->mMutex);
+
+    while(atomic_load(&jobs->mDoneJobs) < jobCount) {
+        pthread_cond_wait(&jobs->mCondition, &jobs->mMutex);
+    }
+
+    pthread_mutex_unlock(&jobs->mMutex);
+
+    __MTReleaseJobs(jobs);
+}
+
+/**
+ * @brief Queue fn(pArgs) to be run on main thread by MTRunMainQueue (WRun calls it once per frame), can be called from any thread
+ *
+ * @param fn task function
+ * @param pArgs task function arguments
+ */
+void MTPostToMain(PFN_MTTaskFunction fn, void* pArgs) {
+    __MTQueuePush(&gMTMainQueue, fn, pArgs);
+}
+
+/**
+ * @brief Run tasks posted to main thread until time budget is spent, at least one task is run so queue always makes progress
+ *
+ * @param budget time budget in seconds
+ * @return uint32_t amount of run tasks
+ */
+uint32_t MTRunMainQueue(double budget) {
+    struct timespec time_spec;
+    timespec_get(&time_spec, TIME_UTC);
+
+    double start = (double)time_spec.tv_sec + (double)time_spec.tv_nsec / 1000000000.0;
+    uint32_t run = 0;
+
+    for(;;) {
+        pthread_mutex_lock(&gMTMainQueue.mMutex);
+        MTTask_t* task = __MTQueuePop(&gMTMainQueue);
+        pthread_mutex_unlock(&gMTMainQueue.mMutex);
+
+        if(task == nullptr) {
+            break;
+        }
+
+        task->mFn(task->mArgs);
+        MECFree(task);
+        run++;
+
+        timespec_get(&time_spec, TIME_UTC);
+
+        if((double)time_spec.tv_sec + (double)time_spec.tv_nsec / 1000000000.0 - start >= budget) {
+            break;
+        }
+    }
+
+    return run;
+}
+
+#endif
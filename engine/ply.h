@@ -0,0 +1,463 @@
+#ifndef _EFFECTIVE_PLY_
+#define _EFFECTIVE_PLY_
+
+#include <stdint.h>
+#include <string.h>
+#include "core.h"
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define PLY_HOST_BIG_ENDIAN true
+#else
+#define PLY_HOST_BIG_ENDIAN false
+#endif
+
+#define PLY_NAME_SIZE 32
+#define PLY_MAX_PROPERTIES 32
+#define PLY_MAX_ELEMENTS 16
+#define PLY_MAX_FACE_INDICES 256
+
+typedef enum PLYFormat_e {
+    PLY_FORMAT_ASCII,
+    PLY_FORMAT_BINARY_LITTLE_ENDIAN,
+    PLY_FORMAT_BINARY_BIG_ENDIAN
+} PLYFormat_t;
+
+typedef enum PLYType_e {
+    PLY_TYPE_NONE,
+    PLY_TYPE_CHAR,
+    PLY_TYPE_UCHAR,
+    PLY_TYPE_SHORT,
+    PLY_TYPE_USHORT,
+    PLY_TYPE_INT,
+    PLY_TYPE_UINT,
+    PLY_TYPE_FLOAT,
+    PLY_TYPE_DOUBLE
+} PLYType_t;
+
+typedef struct PLYProperty_s {
+    char mName[PLY_NAME_SIZE];
+    PLYType_t mType;
+    PLYType_t mCountType;
+    uint32_t mOffset;
+    bool mList;
+} PLYProperty_t;
+
+typedef struct PLYElement_s {
+    char mName[PLY_NAME_SIZE];
+    size_t mCount;
+    PLYProperty_t mProperties[PLY_MAX_PROPERTIES];
+    uint32_t mPropertyCount;
+    uint32_t mStride;
+    bool mFixedSize;
+} PLYElement_t;
+
+typedef struct PLYHeader_s {
+    PLYFormat_t mFormat;
+    PLYElement_t mElements[PLY_MAX_ELEMENTS];
+    uint32_t mElementCount;
+    size_t mHeaderSize;
+} PLYHeader_t;
+
+/**
+ * @brief Get size of .ply type in bytes
+ *
+ * @param type
+ * @return uint32_t
+ */
+uint32_t PLYTypeSize(PLYType_t type) {
+    switch(type) {
+        case PLY_TYPE_CHAR: case PLY_TYPE_UCHAR: return 1;
+        case PLY_TYPE_SHORT: case PLY_TYPE_USHORT: return 2;
+        case PLY_TYPE_INT: case PLY_TYPE_UINT: case PLY_TYPE_FLOAT: return 4;
+        case PLY_TYPE_DOUBLE: return 8;
+        default: return 0;
+    }
+}
+
+/**
+ * @brief Compares header token with null terminated string
+ *
+ * @param token token start
+ * @param tokenSize token size
+ * @param str compared string
+ * @return true when equal
+ */
+bool __PLYTokenIs(const char* token, size_t tokenSize, const char* str) {
+    return strlen(str) == tokenSize && memcmp(token, str, tokenSize) == 0;
+}
+
+PLYType_t __PLYParseType(const char* token, size_t tokenSize) {
+    if(__PLYTokenIs(token, tokenSize, "char") || __PLYTokenIs(token, tokenSize, "int8")) return PLY_TYPE_CHAR;
+    if(__PLYTokenIs(token, tokenSize, "uchar") || __PLYTokenIs(token, tokenSize, "uint8")) return PLY_TYPE_UCHAR;
+    if(__PLYTokenIs(token, tokenSize, "short") || __PLYTokenIs(token, tokenSize, "int16")) return PLY_TYPE_SHORT;
+    if(__PLYTokenIs(token, tokenSize, "ushort") || __PLYTokenIs(token, tokenSize, "uint16")) return PLY_TYPE_USHORT;
+    if(__PLYTokenIs(token, tokenSize, "int") || __PLYTokenIs(token, tokenSize, "int32")) return PLY_TYPE_INT;
+    if(__PLYTokenIs(token, tokenSize, "uint") || __PLYTokenIs(token, tokenSize, "uint32")) return PLY_TYPE_UINT;
+    if(__PLYTokenIs(token, tokenSize, "float") || __PLYTokenIs(token, tokenSize, "float32")) return PLY_TYPE_FLOAT;
+    if(__PLYTokenIs(token, tokenSize, "double") || __PLYTokenIs(token, tokenSize, "float64")) return PLY_TYPE_DOUBLE;
+
+    return PLY_TYPE_NONE;
+}
+
+/**
+ * @brief Splits header line into whitespace separated tokens
+ *
+ * @param line line start
+ * @param lineSize line size
+ * @param tokens token starts output
+ * @param tokenSizes token sizes output
+ * @param maxTokens size of token arrays
+ * @return uint32_t tokens found
+ */
+uint32_t __PLYTokenizeLine(const char* line, size_t lineSize, const char** tokens, size_t* tokenSizes, uint32_t maxTokens) {
+    uint32_t token_count = 0;
+    size_t i = 0;
+
+    while(i < lineSize && token_count < maxTokens) {
+        while(i < lineSize && (line[i] == ' ' || line[i] == '\t' || line[i] == '\r')) i++;
+
+        if(i >= lineSize) break;
+
+        tokens[token_count] = line + i;
+
+        while(i < lineSize && line[i] != ' ' && line[i] != '\t' && line[i] != '\r') i++;
+
+        tokenSizes[token_count] = (size_t)(line + i - tokens[token_count]);
+        token_count++;
+    }
+
+    return token_count;
+}
+
+void __PLYCopyName(char* dst, const char* token, size_t tokenSize) {
+    size_t size = tokenSize < PLY_NAME_SIZE - 1 ? tokenSize : PLY_NAME_SIZE - 1;
+
+    memcpy(dst, token, size);
+    dst[size] = '\0';
+}
+
+/**
+ * @brief Parse .ply header in one pass, stops at end_header and builds element/property schema with byte offsets
+ *
+ * @param pHeader header output
+ * @param src .ply file contents (don`t need to be null terminated)
+ * @param size .ply file size
+ * @return true when header is valid
+ */
+bool PLYParseHeader(PLYHeader_t* pHeader, const uint8_t* src, size_t size) {
+    memset(pHeader, 0, sizeof(PLYHeader_t));
+
+    if(size < 4 || memcmp(src, "ply", 3) != 0 || (src[3] != '\n' && src[3] != '\r')) {
+        E_WARN("Source is not .ply file!");
+
+        return false;
+    }
+
+    bool has_format = false;
+    size_t cursor = 0;
+
+    while(cursor < size) {
+        const uint8_t* line_end = (const uint8_t*)memchr(src + cursor, '\n', size - cursor);
+
+        if(line_end == nullptr) {
+            break;
+        }
+
+        const char* line = (const char*)src + cursor;
+        size_t line_size = (size_t)((const char*)line_end - line);
+
+        cursor += line_size + 1;
+
+        const char* tokens[6];
+        size_t token_sizes[6];
+        uint32_t token_count = __PLYTokenizeLine(line, line_size, tokens, token_sizes, 6);
+
+        if(token_count == 0) {
+            continue;
+        }
+
+        if(__PLYTokenIs(tokens[0], token_sizes[0], "end_header")) {
+            if(!has_format) {
+                E_WARN(".ply header has no format line!");
+
+                return false;
+            }
+
+            pHeader->mHeaderSize = cursor;
+
+            return true;
+        }
+        else if(__PLYTokenIs(tokens[0], token_sizes[0], "format")) {
+            if(token_count < 2) {
+                E_WARN("Invalid .ply format line!");
+
+                return false;
+            }
+
+            if(__PLYTokenIs(tokens[1], token_sizes[1], "ascii")) pHeader->mFormat = PLY_FORMAT_ASCII;
+            else if(__PLYTokenIs(tokens[1], token_sizes[1], "binary_little_endian")) pHeader->mFormat = PLY_FORMAT_BINARY_LITTLE_ENDIAN;
+            else if(__PLYTokenIs(tokens[1], token_sizes[1], "binary_big_endian")) pHeader->mFormat = PLY_FORMAT_BINARY_BIG_ENDIAN;
+            else {
+                E_WARN("Unknown .ply format!");
+
+                return false;
+            }
+
+            has_format = true;
+        }
+        else if(__PLYTokenIs(tokens[0], token_sizes[0], "element")) {
+            if(token_count < 3) {
+                E_WARN("Invalid .ply element line!");
+
+                return false;
+            }
+
+            if(pHeader->mElementCount >= PLY_MAX_ELEMENTS) {
+                E_WARN_ARG("Too many .ply elements, engine supports up to %d!", PLY_MAX_ELEMENTS);
+
+                return false;
+            }
+
+            PLYElement_t* element = &pHeader->mElements[pHeader->mElementCount++];
+
+            __PLYCopyName(element->mName, tokens[1], token_sizes[1]);
+            element->mFixedSize = true;
+
+            for(size_t i = 0; i < token_sizes[2]; i++) {
+                if(tokens[2][i] < '0' || tokens[2][i] > '9') {
+                    E_WARN_ARG("Invalid count of .ply element \"%s\"!", element->mName);
+
+                    return false;
+                }
+
+                element->mCount = element->mCount * 10 + (size_t)(tokens[2][i] - '0');
+            }
+        }
+        else if(__PLYTokenIs(tokens[0], token_sizes[0], "property")) {
+            if(pHeader->mElementCount == 0) {
+                E_WARN(".ply property declared before any element!");
+
+                return false;
+            }
+
+            PLYElement_t* element = &pHeader->mElements[pHeader->mElementCount - 1];
+
+            if(element->mPropertyCount >= PLY_MAX_PROPERTIES) {
+                E_WARN_ARG("Too many properties in .ply element \"%s\", engine supports up to %d!", element->mName, PLY_MAX_PROPERTIES);
+
+                return false;
+            }
+
+            PLYProperty_t* property = &element->mProperties[element->mPropertyCount];
+
+            if(token_count >= 5 && __PLYTokenIs(tokens[1], token_sizes[1], "list")) {
+                property->mList = true;
+                property->mCountType = __PLYParseType(tokens[2], token_sizes[2]);
+                property->mType = __PLYParseType(tokens[3], token_sizes[3]);
+                __PLYCopyName(property->mName, tokens[4], token_sizes[4]);
+            }
+            else if(token_count >= 3) {
+                property->mType = __PLYParseType(tokens[1], token_sizes[1]);
+                __PLYCopyName(property->mName, tokens[2], token_sizes[2]);
+            }
+
+            if(property->mType == PLY_TYPE_NONE || (property->mList && (property->mCountType == PLY_TYPE_NONE || property->mCountType == PLY_TYPE_FLOAT || property->mCountType == PLY_TYPE_DOUBLE))) {
+                E_WARN_ARG("Invalid .ply property in element \"%s\"!", element->mName);
+
+                return false;
+            }
+
+            property->mOffset = element->mFixedSize ? element->mStride : UINT32_MAX;
+
+            if(property->mList) {
+                element->mFixedSize = false;
+            }
+            else if(element->mFixedSize) {
+                element->mStride += PLYTypeSize(property->mType);
+            }
+
+            element->mPropertyCount++;
+        }
+        else if(!__PLYTokenIs(tokens[0], token_sizes[0], "ply") && !__PLYTokenIs(tokens[0], token_sizes[0], "comment") && !__PLYTokenIs(tokens[0], token_sizes[0], "obj_info")) {
+            E_WARN("Unknown .ply header line, skipping it!");
+        }
+    }
+
+    E_WARN("Cannot find end of .ply header!");
+
+    return false;
+}
+
+/**
+ * @brief Find element in .ply schema
+ *
+ * @param pHeader header pointer
+ * @param name element name
+ * @return int32_t element index or -1 when not found
+ */
+int32_t PLYFindElement(const PLYHeader_t* pHeader, const char* name) {
+    for(uint32_t i = 0; i < pHeader->mElementCount; i++) {
+        if(strcmp(pHeader->mElements[i].mName, name) == 0) {
+            return (int32_t)i;
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * @brief Find property in .ply element
+ *
+ * @param pElement element pointer
+ * @param name property name
+ * @return int32_t property index or -1 when not found
+ */
+int32_t PLYFindProperty(const PLYElement_t* pElement, const char* name) {
+    for(uint32_t i = 0; i < pElement->mPropertyCount; i++) {
+        if(strcmp(pElement->mProperties[i].mName, name) == 0) {
+            return (int32_t)i;
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * @brief Reads one .ply value as float, readers are chosen once per property by PLYGetValueReader so records are decoded without type switches
+ */
+typedef float (*PFN_PLYReadValue)(const uint8_t* src);
+
+float __PLYReadChar(const uint8_t* src) { return (float)(int8_t)src[0]; }
+float __PLYReadUChar(const uint8_t* src) { return (float)src[0]; }
+
+float __PLYReadShort(const uint8_t* src) { int16_t value; memcpy(&value, src, sizeof(value)); return (float)value; }
+float __PLYReadUShort(const uint8_t* src) { uint16_t value; memcpy(&value, src, sizeof(value)); return (float)value; }
+float __PLYReadInt(const uint8_t* src) { int32_t value; memcpy(&value, src, sizeof(value)); return (float)value; }
+float __PLYReadUInt(const uint8_t* src) { uint32_t value; memcpy(&value, src, sizeof(value)); return (float)value; }
+float __PLYReadFloat(const uint8_t* src) { float value; memcpy(&value, src, sizeof(value)); return value; }
+float __PLYReadDouble(const uint8_t* src) { double value; memcpy(&value, src, sizeof(value)); return (float)value; }
+
+float __PLYReadShortSwapped(const uint8_t* src) { uint8_t bytes[2] = { src[1], src[0] }; return __PLYReadShort(bytes); }
+float __PLYReadUShortSwapped(const uint8_t* src) { uint8_t bytes[2] = { src[1], src[0] }; return __PLYReadUShort(bytes); }
+float __PLYReadIntSwapped(const uint8_t* src) { uint8_t bytes[4] = { src[3], src[2], src[1], src[0] }; return __PLYReadInt(bytes); }
+float __PLYReadUIntSwapped(const uint8_t* src) { uint8_t bytes[4] = { src[3], src[2], src[1], src[0] }; return __PLYReadUInt(bytes); }
+float __PLYReadFloatSwapped(const uint8_t* src) { uint8_t bytes[4] = { src[3], src[2], src[1], src[0] }; return __PLYReadFloat(bytes); }
+float __PLYReadDoubleSwapped(const uint8_t* src) { uint8_t bytes[8] = { src[7], src[6], src[5], src[4], src[3], src[2], src[1], src[0] }; return __PLYReadDouble(bytes); }
+
+/**
+ * @brief Get binary reader of .ply type
+ *
+ * @param type value type
+ * @param swap true when source endianess differs from host
+ * @return PFN_PLYReadValue reader or nullptr for PLY_TYPE_NONE
+ */
+PFN_PLYReadValue PLYGetValueReader(PLYType_t type, bool swap) {
+    switch(type) {
+        case PLY_TYPE_CHAR: return __PLYReadChar;
+        case PLY_TYPE_UCHAR: return __PLYReadUChar;
+        case PLY_TYPE_SHORT: return swap ? __PLYReadShortSwapped : __PLYReadShort;
+        case PLY_TYPE_USHORT: return swap ? __PLYReadUShortSwapped : __PLYReadUShort;
+        case PLY_TYPE_INT: return swap ? __PLYReadIntSwapped : __PLYReadInt;
+        case PLY_TYPE_UINT: return swap ? __PLYReadUIntSwapped : __PLYReadUInt;
+        case PLY_TYPE_FLOAT: return swap ? __PLYReadFloatSwapped : __PLYReadFloat;
+        case PLY_TYPE_DOUBLE: return swap ? __PLYReadDoubleSwapped : __PLYReadDouble;
+        default: return nullptr;
+    }
+}
+
+/**
+ * @brief Get value that maps to 1.0 for normalized integer .ply types (e.g. uchar color 255)
+ *
+ * @param type value type
+ * @return float maximum value, 1.0 for float types
+ */
+float PLYTypeMaximum(PLYType_t type) {
+    switch(type) {
+        case PLY_TYPE_CHAR: return 127.0f;
+        case PLY_TYPE_UCHAR: return 255.0f;
+        case PLY_TYPE_SHORT: return 32767.0f;
+        case PLY_TYPE_USHORT: return 65535.0f;
+        case PLY_TYPE_INT: return 2147483647.0f;
+        case PLY_TYPE_UINT: return 4294967295.0f;
+        default: return 1.0f;
+    }
+}
+
+/**
+ * @brief Read .ply value as integer (used for list counts and indices, float values are truncated)
+ *
+ * @param src value bytes
+ * @param type value type
+ * @param bigEndian source endianess
+ * @return uint32_t
+ */
+uint32_t PLYReadIndex(const uint8_t* src, PLYType_t type, bool bigEndian) {
+    switch(type) {
+        case PLY_TYPE_CHAR: return (uint32_t)(int8_t)src[0];
+        case PLY_TYPE_UCHAR: return src[0];
+        case PLY_TYPE_SHORT: return (uint32_t)(int16_t)(bigEndian ? ((uint16_t)src[0] << 8) | src[1] : ((uint16_t)src[1] << 8) | src[0]);
+        case PLY_TYPE_USHORT: return bigEndian ? ((uint32_t)src[0] << 8) | src[1] : ((uint32_t)src[1] << 8) | src[0];
+        case PLY_TYPE_INT:
+        case PLY_TYPE_UINT:
+            return bigEndian ? ((uint32_t)src[0] << 24) | ((uint32_t)src[1] << 16) | ((uint32_t)src[2] << 8) | src[3]
+                             : ((uint32_t)src[3] << 24) | ((uint32_t)src[2] << 16) | ((uint32_t)src[1] << 8) | src[0];
+        case PLY_TYPE_FLOAT:
+        case PLY_TYPE_DOUBLE: {
+            float value = PLYGetValueReader(type, bigEndian != PLY_HOST_BIG_ENDIAN)(src);
+
+            return value > 0.0f ? (uint32_t)value : 0;
+        }
+        default: return 0;
+    }
+}
+
+/**
+ * @brief Swap byte order of 32 bit words in bulk (SSSE3/SSE2/NEON when available), src and dst can be the same memory
+ *
+ * @param dst destination
+ * @param src source (don`t need to be aligned)
+ * @param count amount of 32 bit words
+ */
+void PLYSwapBytes32(void* dst, const void* src, size_t count) {
+    uint8_t* dst_bytes = (uint8_t*)dst;
+    const uint8_t* src_bytes = (const uint8_t*)src;
+    size_t i = 0;
+
+#if defined(__SSSE3__)
+    const __m128i shuffle = _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+
+    for(; i + 4 <= count; i += 4) {
+        __m128i words = _mm_loadu_si128((const __m128i*)(src_bytes + i * 4));
+        _mm_storeu_si128((__m128i*)(dst_bytes + i * 4), _mm_shuffle_epi8(words, shuffle));
+    }
+#elif defined(__SSE2__) || defined(_M_X64)
+    for(; i + 4 <= count; i += 4) {
+        __m128i words = _mm_loadu_si128((const __m128i*)(src_bytes + i * 4));
+        words = _mm_or_si128(_mm_slli_epi16(words, 8), _mm_srli_epi16(words, 8));
+        words = _mm_shufflehi_epi16(_mm_shufflelo_epi16(words, _MM_SHUFFLE(2, 3, 0, 1)), _MM_SHUFFLE(2, 3, 0, 1));
+        _mm_storeu_si128((__m128i*)(dst_bytes + i * 4), words);
+    }
+#elif defined(__ARM_NEON)
+    for(; i + 4 <= count; i += 4) {
+        vst1q_u8(dst_bytes + i * 4, vrev32q_u8(vld1q_u8(src_bytes + i * 4)));
+    }
+#endif
+
+    for(; i < count; i++) {
+        uint32_t word;
+
+        memcpy(&word, src_bytes + i * 4, sizeof(uint32_t));
+        word = ((word & 0xff) << 24) | ((word & 0xff00) << 8) | ((word & 0xff0000) >> 8) | ((word & 0xff000000) >> 24);
+        memcpy(dst_bytes + i * 4, &word, sizeof(uint32_t));
+    }
+}
+
+#endif
@@ -70,7 +70,64 @@ void RRender(Renderer_t* pRend, RenderData_t* pRd, uint32_t mode, bool useFrameb
         if(pRd->mTexturesPtr[i] != nullptr) TABindUnit(pRd->mTexturesPtr[i], i);
     }
 
-    glDrawArrays(mode, 0, pRd->mMeshPtr->mJoinedMesh.mMeshSize);
+    float position_offset[3] = {0.0f, 0.0f, 0.0f};
+    float position_scale[3] = {1.0f, 1.0f, 1.0f};
+
+    if(pRd->mCompact) {
+        for(uint32_t c = 0; c < 3; c++) {
+            position_offset[c] = pRd->mBoundsMin[c];
+            position_scale[c] = pRd->mBoundsMax[c] - pRd->mBoundsMin[c];
+        }
+    }
+
+    glUniform3fv(glGetUniformLocation(pRend->mShaderProgram.mId, "uPositionOffset"), 1, position_offset);
+    glUniform3fv(glGetUniformLocation(pRend->mShaderProgram.mId, "uPositionScale"), 1, position_scale);
+    glUniform1i(glGetUniformLocation(pRend->mShaderProgram.mId, "uOctahedralNormals"), pRd->mSourceDrawCount == 0 && pRd->mFormat.mAttributes[2].mDimmensions == 2);
+
+    if(pRd->mSourceDrawCount == 0) {
+        for(uint32_t i = 0; i < VF_MAX_ATTRIBUTES; i++) {
+            if(pRd->mFormat.mAttributes[i].mDimmensions == 0) __RDSetAttributeDefault(i);
+        }
+    }
+
+    // mesh matrices are taken as uploaded, call RDUpdateTransforms after moving meshes
+    bool gpu_transforms = pRd->mSourceDrawCount == 0 && pRd->mMeshPtr != nullptr && pRd->mMeshPtr->mGPUTransforms;
+
+    if(gpu_transforms) {
+        SBBindBase(&pRd->mTransformBuffer, 0);
+    }
+
+    glUniform1i(glGetUniformLocation(pRend->mShaderProgram.mId, "uGPUTransforms"), gpu_transforms);
+
+    if(pRd->mSourceDrawCount != 0) {
+        // source draws carry own primitive modes
+        for(uint32_t i = 0; i < pRd->mSourceDrawCount; i++) {
+            const RDSourceDraw_t* draw = &pRd->mSourceDraws[i];
+
+            __RDBindSourceDraw(pRd, draw);
+
+            if(draw->mIndexType != 0) {
+                glDrawElements(draw->mMode, draw->mCount, draw->mIndexType, (const void*)draw->mIndexOffset);
+            }
+            else {
+                glDrawArrays(draw->mMode, 0, draw->mCount);
+            }
+        }
+    }
+    else if(pRd->mMultiDraw) {
+        if(pRd->mDrawCount != 0) {
+            glMultiDrawElements(mode, pRd->mDrawCounts, pRd->mIndexType, pRd->mDrawOffsets, pRd->mDrawCount);
+        }
+    }
+    else if(pRd->mIndexCapacity != 0) {
+        // indexed mesh with vertices uploaded but indices not yet (see RDAppendMeshChunk) draws nothing
+        if(pRd->mIndexCount != 0) {
+            glDrawElements(mode, pRd->mIndexCount, pRd->mIndexType, nullptr);
+        }
+    }
+    else {
+        glDrawArrays(mode, 0, pRd->mVertexCount);
+    }
 
     VAUnbind();
     SPUnuse();
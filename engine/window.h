@@ -11,6 +11,7 @@
 #include <stdint.h>
 
 #include "core.h"
+#include "multithreader.h"
 
 typedef void (*PFN_WindowFunction)();
 
@@ -19,6 +20,7 @@ typedef struct Window_s {
     PFN_WindowFunction mStartFn, mUpdateFn, mLateUpdateFn, mFixedUpdateFn, mEndFn, mAwakeFn;
     bool mFixedUpdateRunning;
     uint32_t mFixedUpdateFramerate;
+    double mMainQueueBudget;
 } Window_t;
 
 struct Time_s {
@@ -76,6 +78,14 @@ void WSetFixedUpdate(Window_t* pWnd, PFN_WindowFunction fn) { pWnd->mFixedUpdate
  */
 void WSetEnd(Window_t* pWnd, PFN_WindowFunction fn) { pWnd->mEndFn = fn; }
 
+/**
+ * @brief Set time per frame spent on tasks posted to main thread (e.g. finished asset loads and their GL uploads), default is 4 ms
+ * 
+ * @param pWnd window pointer
+ * @param budget budget in seconds
+ */
+void WSetMainQueueBudget(Window_t* pWnd, double budget) { pWnd->mMainQueueBudget = budget; }
+
 /**
  * @brief DO NOT TOUCH THIS, this is main handler of fixed update thread
  * 
@@ -111,6 +121,8 @@ void WRun(Window_t* pWnd, int width, int height, const char* title) {
     pWnd->mFixedUpdateFramerate = 128;
     pWnd->mFixedUpdateRunning = true;
 
+    if(pWnd->mMainQueueBudget <= 0.0) pWnd->mMainQueueBudget = 0.004;
+
     if(pWnd->mAwakeFn != nullptr) pWnd->mAwakeFn(); 
 
     glfwInit();
@@ -153,6 +165,8 @@ void WRun(Window_t* pWnd, int width, int height, const char* title) {
         glClear(0x100 | 0x4000);
         glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
 
+        MTRunMainQueue(pWnd->mMainQueueBudget);
+
         if(pWnd->mUpdateFn != nullptr) pWnd->mUpdateFn();
 
         glfwSwapBuffers(pWnd->mWindow);
@@ -164,6 +178,8 @@ void WRun(Window_t* pWnd, int width, int height, const char* title) {
 
     if(pWnd->mEndFn != nullptr) pWnd->mEndFn();
 
+    MTPoolStop();
+
     glfwTerminate();
     
     return;
@@ -0,0 +1,254 @@
+#ifndef _EFFECTIVE_BENCH_GENERATOR_
+#define _EFFECTIVE_BENCH_GENERATOR_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include "../../engine/core.h"
+#include "../../engine/ply.h"
+
+typedef enum GenShape_e {
+    GEN_SHAPE_TRIANGLES,
+    GEN_SHAPE_QUADS,
+    GEN_SHAPE_MIXED,
+} GenShape_t;
+
+typedef struct GenWriter_s {
+    FILE* mFile;
+    PLYFormat_t mFormat;
+    uint8_t mBuffer[1 << 16];
+    size_t mSize;
+    bool mFailed;
+} GenWriter_t;
+
+const char* GenShapeName(GenShape_t shape) {
+    switch(shape) {
+        case GEN_SHAPE_TRIANGLES: return "triangles";
+        case GEN_SHAPE_QUADS: return "quads";
+        default: return "mixed";
+    }
+}
+
+const char* GenFormatName(PLYFormat_t format) {
+    switch(format) {
+        case PLY_FORMAT_ASCII: return "ascii";
+        case PLY_FORMAT_BINARY_LITTLE_ENDIAN: return "binary_little_endian";
+        default: return "binary_big_endian";
+    }
+}
+
+void __GenFlush(GenWriter_t* pWriter) {
+    if(pWriter->mSize != 0 && fwrite(pWriter->mBuffer, 1, pWriter->mSize, pWriter->mFile) != pWriter->mSize) {
+        pWriter->mFailed = true;
+    }
+
+    pWriter->mSize = 0;
+}
+
+void __GenWrite(GenWriter_t* pWriter, const void* src, size_t size) {
+    if(pWriter->mSize + size > sizeof(pWriter->mBuffer)) {
+        __GenFlush(pWriter);
+    }
+
+    memcpy(pWriter->mBuffer + pWriter->mSize, src, size);
+    pWriter->mSize += size;
+}
+
+/**
+ * @brief DO NOT TOUCH THIS, writes binary value in file byte order
+ *
+ * @param pWriter writer pointer
+ * @param src value bytes in host order
+ * @param size value size
+ */
+void __GenWriteValue(GenWriter_t* pWriter, const void* src, size_t size) {
+    uint8_t bytes[8];
+    bool swap = (pWriter->mFormat == PLY_FORMAT_BINARY_BIG_ENDIAN) != PLY_HOST_BIG_ENDIAN;
+
+    for(size_t i = 0; i < size; i++) {
+        bytes[i] = ((const uint8_t*)src)[swap ? size - 1 - i : i];
+    }
+
+    __GenWrite(pWriter, bytes, size);
+}
+
+/**
+ * @brief DO NOT TOUCH THIS, writes vertex record (x y z nx ny nz s t as float, red green blue as uchar)
+ *
+ * @param pWriter writer pointer
+ * @param position
+ * @param textureCoordinates
+ */
+void __GenWriteVertex(GenWriter_t* pWriter, const float* position, const float* textureCoordinates) {
+    const float normal[3] = { 0.0f, 0.0f, 1.0f };
+    const uint8_t color[3] = { (uint8_t)(textureCoordinates[0] * 255.0f), (uint8_t)(textureCoordinates[1] * 255.0f), 128 };
+
+    if(pWriter->mFormat == PLY_FORMAT_ASCII) {
+        char line[256];
+        int size = snprintf(line, sizeof(line), "%g %g %g %g %g %g %g %g %u %u %u\n", position[0], position[1], position[2], normal[0], normal[1], normal[2], textureCoordinates[0], textureCoordinates[1], color[0], color[1], color[2]);
+
+        __GenWrite(pWriter, line, (size_t)size);
+
+        return;
+    }
+
+    for(uint32_t c = 0; c < 3; c++) __GenWriteValue(pWriter, &position[c], sizeof(float));
+    for(uint32_t c = 0; c < 3; c++) __GenWriteValue(pWriter, &normal[c], sizeof(float));
+    for(uint32_t c = 0; c < 2; c++) __GenWriteValue(pWriter, &textureCoordinates[c], sizeof(float));
+
+    __GenWrite(pWriter, color, sizeof(color));
+}
+
+void __GenWriteFace(GenWriter_t* pWriter, const uint32_t* face, uint32_t faceSize) {
+    if(pWriter->mFormat == PLY_FORMAT_ASCII) {
+        char line[256];
+        int size = snprintf(line, sizeof(line), "%u", faceSize);
+
+        for(uint32_t i = 0; i < faceSize; i++) {
+            size += snprintf(line + size, sizeof(line) - (size_t)size, " %u", face[i]);
+        }
+
+        line[size++] = '\n';
+        __GenWrite(pWriter, line, (size_t)size);
+
+        return;
+    }
+
+    uint8_t count = (uint8_t)faceSize;
+    __GenWrite(pWriter, &count, 1);
+
+    for(uint32_t i = 0; i < faceSize; i++) {
+        __GenWriteValue(pWriter, &face[i], sizeof(uint32_t));
+    }
+}
+
+/**
+ * @brief DO NOT TOUCH THIS, size of mixed n-gon (3 - 8 corners) of face index
+ *
+ * @param face face index
+ * @return uint32_t
+ */
+uint32_t __GenMixedFaceSize(size_t face) {
+    return 3 + (uint32_t)((face * 2654435761u) >> 7) % 6;
+}
+
+/**
+ * @brief Generate synthetic .ply file. Triangles and quads are grid with shared vertices, mixed n-gons (3 - 8 corners) are separate convex polygons
+ *
+ * @param path output path
+ * @param format .ply body format
+ * @param shape face shape
+ * @param faceCount amount of faces
+ * @param pVertexCount output amount of vertices
+ * @return true when file was written
+ */
+bool GenWritePLY(const char* path, PLYFormat_t format, GenShape_t shape, size_t faceCount, size_t* pVertexCount) {
+    GenWriter_t* writer = (GenWriter_t*)MECCalloc(1, sizeof(GenWriter_t));
+    writer->mFile = fopen(path, "wb");
+    writer->mFormat = format;
+
+    if(writer->mFile == nullptr) {
+        E_WARN_ARG("Cannot create benchmark model \"%s\"!", path);
+
+        MECFree(writer);
+
+        return false;
+    }
+
+    uint32_t faces_per_cell = shape == GEN_SHAPE_TRIANGLES ? 2 : 1;
+    size_t cells = (faceCount + faces_per_cell - 1) / faces_per_cell;
+    size_t width = (size_t)ceil(sqrt((double)cells));
+    size_t height = width == 0 ? 0 : (cells + width - 1) / width;
+    size_t vertex_count = 0;
+
+    if(shape == GEN_SHAPE_MIXED) {
+        for(size_t f = 0; f < faceCount; f++) {
+            vertex_count += __GenMixedFaceSize(f);
+        }
+    }
+    else {
+        vertex_count = (width + 1) * (height + 1);
+    }
+
+    char header[512];
+    int header_size = snprintf(header, sizeof(header), "ply\nformat %s 1.0\ncomment effective engine benchmark model\nelement vertex %zu\n"
+        "property float x\nproperty float y\nproperty float z\nproperty float nx\nproperty float ny\nproperty float nz\nproperty float s\nproperty float t\n"
+        "property uchar red\nproperty uchar green\nproperty uchar blue\nelement face %zu\nproperty list uchar uint vertex_indices\nend_header\n", GenFormatName(format), vertex_count, faceCount);
+
+    __GenWrite(writer, header, (size_t)header_size);
+
+    if(shape == GEN_SHAPE_MIXED) {
+        for(size_t f = 0; f < faceCount; f++) {
+            uint32_t size = __GenMixedFaceSize(f);
+            float center[2] = { (float)(f % 4096) * 3.0f, (float)(f / 4096) * 3.0f };
+
+            for(uint32_t i = 0; i < size; i++) {
+                float angle = 6.2831853f * (float)i / (float)size;
+                float position[3] = { center[0] + cosf(angle), center[1] + sinf(angle), 0.0f };
+                float texture_coordinates[2] = { 0.5f + 0.5f * cosf(angle), 0.5f + 0.5f * sinf(angle) };
+
+                __GenWriteVertex(writer, position, texture_coordinates);
+            }
+        }
+    }
+    else {
+        for(size_t y = 0; y <= height; y++) {
+            for(size_t x = 0; x <= width; x++) {
+                float position[3] = { (float)x, (float)y, sinf((float)x * 0.05f) * cosf((float)y * 0.05f) };
+                float texture_coordinates[2] = { (float)x / (float)width, (float)y / (float)height };
+
+                __GenWriteVertex(writer, position, texture_coordinates);
+            }
+        }
+    }
+
+    uint32_t first = 0;
+
+    for(size_t f = 0; f < faceCount; f++) {
+        size_t cell = f / faces_per_cell;
+        uint32_t a = (uint32_t)((cell / width) * (width + 1) + cell % width);
+        uint32_t b = a + 1, c = a + (uint32_t)width + 2, d = a + (uint32_t)width + 1;
+        uint32_t face[8];
+        uint32_t size = 3;
+
+        if(shape == GEN_SHAPE_MIXED) {
+            size = __GenMixedFaceSize(f);
+
+            for(uint32_t i = 0; i < size; i++) {
+                face[i] = first + i;
+            }
+
+            first += size;
+        }
+        else if(shape == GEN_SHAPE_QUADS) {
+            face[0] = a; face[1] = b; face[2] = c; face[3] = d;
+            size = 4;
+        }
+        else if(f % 2 == 0) {
+            face[0] = a; face[1] = b; face[2] = c;
+        }
+        else {
+            face[0] = a; face[1] = c; face[2] = d;
+        }
+
+        __GenWriteFace(writer, face, size);
+    }
+
+    __GenFlush(writer);
+
+    bool closed = fclose(writer->mFile) == 0;
+    bool written = !writer->mFailed && closed;
+
+    if(!written) {
+        E_WARN_ARG("Cannot write benchmark model \"%s\"!", path);
+    }
+
+    MECFree(writer);
+
+    *pVertexCount = vertex_count;
+
+    return written;
+}
+
+#endif
@@ -0,0 +1,304 @@
+#include <stdio.h>
+#include <time.h>
+#include "../../engine/mesh.h"
+#include "../../engine/mesh_cache.h"
+#include "generator.h"
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#include <sys/wait.h>
+#endif
+
+#ifndef BENCH_REVISION
+#define BENCH_REVISION "unknown"
+#endif
+
+#define BENCH_MAX_PATH 1024
+
+typedef enum BenchMode_e {
+    BENCH_MODE_DEINDEXED,
+    BENCH_MODE_INDEXED,
+    BENCH_MODE_STREAM,
+    BENCH_MODE_CACHED_COLD,
+    BENCH_MODE_CACHED_WARM,
+    BENCH_MODE_COUNT,
+} BenchMode_t;
+
+const char* gBenchModeNames[BENCH_MODE_COUNT] = { "MLoadPLYMeshFromFile", "MLoadPLYIndexedMeshFromFile", "MStreamPLYMeshFromFile", "MLoadPLYMeshCached_cold", "MLoadPLYMeshCached_warm" };
+
+typedef struct BenchResult_s {
+    double mSeconds;
+    size_t mVertexCount;
+    size_t mIndexCount;
+    int64_t mPeakRSS;
+    MECStats_t mAllocations;
+    bool mValid;
+} BenchResult_t;
+
+typedef struct BenchConfig_s {
+    size_t mMaxFaces;
+    uint32_t mRepeat;
+    const char* mOutputPath;
+    const char* mDataDirectory;
+} BenchConfig_t;
+
+double benchTime() {
+    struct timespec time_spec;
+    timespec_get(&time_spec, TIME_UTC);
+
+    return (double)time_spec.tv_sec + (double)time_spec.tv_nsec / 1000000000.0;
+}
+
+void onStreamBatch(void* pUser, const MeshBatch_t* pBatch) {
+    BenchResult_t* result = (BenchResult_t*)pUser;
+
+    if(pBatch->mVertices != nullptr) {
+        result->mVertexCount += pBatch->mVertices->mMeshSize;
+    }
+
+    result->mIndexCount += pBatch->mIndexCount;
+}
+
+/**
+ * @brief Load model once with given loader mode
+ *
+ * @param mode loader mode
+ * @param path model path
+ * @param pResult output vertex and index counts
+ */
+void benchLoad(BenchMode_t mode, const char* path, BenchResult_t* pResult) {
+    Mesh_t mesh;
+    MClearMesh(&mesh);
+
+    pResult->mVertexCount = 0;
+    pResult->mIndexCount = 0;
+
+    switch(mode) {
+        case BENCH_MODE_DEINDEXED: MLoadPLYMeshFromFile(&mesh, path); break;
+        case BENCH_MODE_INDEXED: MLoadPLYIndexedMeshFromFile(&mesh, path); break;
+        case BENCH_MODE_STREAM: MStreamPLYMeshFromFile(path, 0, onStreamBatch, pResult); return;
+        default: MLoadPLYMeshCached(&mesh, path, true, false); break;
+    }
+
+    pResult->mVertexCount = mesh.mMeshSize;
+    pResult->mIndexCount = mesh.mIndexCount;
+
+    if(mesh.mMeshCapacity != 0) {
+        MFreeMesh(&mesh);
+    }
+}
+
+/**
+ * @brief Run loader mode repeat times, best time is kept. Allocation counts are from first run
+ *
+ * @param mode loader mode
+ * @param path model path
+ * @param repeat amount of runs
+ * @return BenchResult_t
+ */
+BenchResult_t benchRun(BenchMode_t mode, const char* path, uint32_t repeat) {
+    BenchResult_t result;
+    memset(&result, 0, sizeof(BenchResult_t));
+
+    char cache_path[BENCH_MAX_PATH];
+    snprintf(cache_path, BENCH_MAX_PATH, "%s.emesh", path);
+
+    if(mode == BENCH_MODE_CACHED_WARM) {
+        benchLoad(mode, path, &result);
+    }
+
+    for(uint32_t i = 0; i < repeat; i++) {
+        if(mode == BENCH_MODE_CACHED_COLD) {
+            remove(cache_path);
+        }
+
+        MECResetStats();
+
+        double start = benchTime();
+        benchLoad(mode, path, &result);
+        double seconds = benchTime() - start;
+
+        if(i == 0) {
+            MECGetStats(&result.mAllocations);
+        }
+
+        result.mSeconds = i == 0 || seconds < result.mSeconds ? seconds : result.mSeconds;
+    }
+
+    remove(cache_path);
+
+#ifndef _WIN32
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    result.mPeakRSS = (int64_t)usage.ru_maxrss * 1024;
+#endif
+
+    result.mValid = true;
+
+    return result;
+}
+
+/**
+ * @brief Run loader mode in own process, so peak RSS belongs to that mode only (on Windows mode runs in benchmark process)
+ *
+ * @param mode loader mode
+ * @param path model path
+ * @param repeat amount of runs
+ * @return BenchResult_t
+ */
+BenchResult_t benchRunIsolated(BenchMode_t mode, const char* path, uint32_t repeat) {
+#ifdef _WIN32
+    return benchRun(mode, path, repeat);
+#else
+    BenchResult_t result;
+    memset(&result, 0, sizeof(BenchResult_t));
+
+    int pipe_ends[2];
+    fflush(stdout);
+
+    if(pipe(pipe_ends) != 0) {
+        return benchRun(mode, path, repeat);
+    }
+
+    pid_t child = fork();
+
+    if(child == 0) {
+        close(pipe_ends[0]);
+
+        // loader logging is not part of measurement
+        if(freopen("/dev/null", "w", stdout) == nullptr) {
+            _exit(1);
+        }
+
+        result = benchRun(mode, path, repeat);
+
+        _exit(write(pipe_ends[1], &result, sizeof(BenchResult_t)) == sizeof(BenchResult_t) ? 0 : 1);
+    }
+
+    close(pipe_ends[1]);
+
+    if(child < 0 || read(pipe_ends[0], &result, sizeof(BenchResult_t)) != sizeof(BenchResult_t)) {
+        result.mValid = false;
+    }
+
+    close(pipe_ends[0]);
+
+    if(child > 0) {
+        waitpid(child, nullptr, 0);
+    }
+
+    return result;
+#endif
+}
+
+bool parseArguments(BenchConfig_t* pConfig, int argc, char** argv) {
+    pConfig->mMaxFaces = 1000000;
+    pConfig->mRepeat = 3;
+    pConfig->mOutputPath = "bench_results.json";
+    pConfig->mDataDirectory = ".";
+
+    for(int i = 1; i < argc; i++) {
+        bool has_value = i + 1 < argc;
+
+        if(strcmp(argv[i], "-max-faces") == 0 && has_value) {
+            pConfig->mMaxFaces = (size_t)strtoull(argv[++i], nullptr, 10);
+        }
+        else if(strcmp(argv[i], "-repeat") == 0 && has_value) {
+            pConfig->mRepeat = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        }
+        else if(strcmp(argv[i], "-threads") == 0 && has_value) {
+            MTSetThreadCount((uint32_t)strtoul(argv[++i], nullptr, 10));
+        }
+        else if(strcmp(argv[i], "-out") == 0 && has_value) {
+            pConfig->mOutputPath = argv[++i];
+        }
+        else if(strcmp(argv[i], "-dir") == 0 && has_value) {
+            pConfig->mDataDirectory = argv[++i];
+        }
+        else {
+            printf("usage: %s [-max-faces N (1000000, up to 50000000)] [-repeat N (3)] [-threads N] [-out results.json] [-dir model directory]\n", argv[0]);
+
+            return false;
+        }
+    }
+
+    pConfig->mRepeat = pConfig->mRepeat == 0 ? 1 : pConfig->mRepeat;
+
+    return true;
+}
+
+int main(int argc, char** argv) {
+    BenchConfig_t config;
+
+    if(!parseArguments(&config, argc, argv)) {
+        return 1;
+    }
+
+    FILE* output = fopen(config.mOutputPath, "w");
+
+    if(output == nullptr) {
+        E_ERR_ARG("Cannot create \"%s\"!", config.mOutputPath);
+
+        return 1;
+    }
+
+    const size_t face_counts[] = { 10000, 100000, 1000000, 10000000, 50000000 };
+    const PLYFormat_t formats[] = { PLY_FORMAT_ASCII, PLY_FORMAT_BINARY_LITTLE_ENDIAN, PLY_FORMAT_BINARY_BIG_ENDIAN };
+    const GenShape_t shapes[] = { GEN_SHAPE_TRIANGLES, GEN_SHAPE_QUADS, GEN_SHAPE_MIXED };
+    bool first_result = true;
+
+    fprintf(output, "{\n  \"revision\": \"%s\",\n  \"threads\": %u,\n  \"repeat\": %u,\n  \"results\": [", BENCH_REVISION, MTGetThreadCount(), config.mRepeat);
+
+    for(uint32_t s = 0; s < sizeof(face_counts) / sizeof(face_counts[0]) && face_counts[s] <= config.mMaxFaces; s++) {
+        for(uint32_t f = 0; f < sizeof(formats) / sizeof(formats[0]); f++) {
+            for(uint32_t g = 0; g < sizeof(shapes) / sizeof(shapes[0]); g++) {
+                char path[BENCH_MAX_PATH];
+                size_t vertex_count = 0;
+                uint64_t file_size = 0;
+                int64_t file_time = 0;
+
+                snprintf(path, BENCH_MAX_PATH, "%s/bench_%s_%s_%zu.ply", config.mDataDirectory, GenFormatName(formats[f]), GenShapeName(shapes[g]), face_counts[s]);
+
+                if(!GenWritePLY(path, formats[f], shapes[g], face_counts[s], &vertex_count) || !FMGetInfo(path, &file_size, &file_time)) {
+                    remove(path);
+
+                    continue;
+                }
+
+                for(uint32_t m = 0; m < BENCH_MODE_COUNT; m++) {
+                    BenchResult_t result = benchRunIsolated((BenchMode_t)m, path, config.mRepeat);
+
+                    if(!result.mValid) {
+                        E_WARN_ARG("Benchmark of %s on \"%s\" failed!", gBenchModeNames[m], path);
+
+                        continue;
+                    }
+
+                    double seconds = result.mSeconds > 0.0 ? result.mSeconds : 1e-9;
+                    double mb_per_second = (double)file_size / 1000000.0 / seconds;
+                    double faces_per_second = (double)face_counts[s] / seconds;
+
+                    printf("%-28s %-20s %-9s %9zu faces %9.3f ms %9.1f MB/s %12.0f faces/s\n", gBenchModeNames[m], GenFormatName(formats[f]), GenShapeName(shapes[g]), face_counts[s], seconds * 1000.0, mb_per_second, faces_per_second);
+
+                    fprintf(output, "%s\n    { \"mode\": \"%s\", \"format\": \"%s\", \"shape\": \"%s\", \"faces\": %zu, \"file_vertices\": %zu, \"file_bytes\": %llu, "
+                        "\"seconds\": %.6f, \"mb_per_s\": %.3f, \"faces_per_s\": %.1f, \"vertices\": %zu, \"indices\": %zu, \"peak_rss_bytes\": %lld, "
+                        "\"allocations\": { \"malloc\": %llu, \"calloc\": %llu, \"realloc\": %llu, \"free\": %llu } }",
+                        first_result ? "" : ",", gBenchModeNames[m], GenFormatName(formats[f]), GenShapeName(shapes[g]), face_counts[s], vertex_count, (unsigned long long)file_size,
+                        seconds, mb_per_second, faces_per_second, result.mVertexCount, result.mIndexCount, (long long)result.mPeakRSS,
+                        (unsigned long long)result.mAllocations.mMallocCount, (unsigned long long)result.mAllocations.mCallocCount, (unsigned long long)result.mAllocations.mReallocCount, (unsigned long long)result.mAllocations.mFreeCount);
+
+                    first_result = false;
+                }
+
+                remove(path);
+            }
+        }
+    }
+
+    fprintf(output, "\n  ]\n}\n");
+    fclose(output);
+
+    printf("Results written to \"%s\"\n", config.mOutputPath);
+
+    return 0;
+}
@@ -0,0 +1,425 @@
+#include <stdio.h>
+#include <sched.h>
+#include "../../engine/mesh.h"
+#include "../../engine/mesh_cache.h"
+#include "../../engine/assets.h"
+
+#define CHECK_MAX_PATH 1024
+#define CHECK_BIG_FACE 300
+#define CHECK_POOL_TASKS 64
+#define CHECK_POOL_JOBS 8
+
+typedef bool (*PFN_CheckCase)(const char* pDirectory);
+
+typedef struct CheckCase_s {
+    const char* mName;
+    PFN_CheckCase mFn;
+} CheckCase_t;
+
+typedef struct CheckStream_s {
+    size_t mVertexCount;
+    size_t mIndexCount;
+} CheckStream_t;
+
+const PLYFormat_t gCheckFormats[] = { PLY_FORMAT_ASCII, PLY_FORMAT_BINARY_LITTLE_ENDIAN, PLY_FORMAT_BINARY_BIG_ENDIAN };
+const char* gCheckFormatNames[] = { "ascii", "binary_little_endian", "binary_big_endian" };
+
+/**
+ * @brief Write value in file byte order
+ */
+void checkWriteValue(FILE* pFile, PLYFormat_t format, const void* src, size_t size) {
+    uint8_t bytes[8];
+    memcpy(bytes, src, size);
+
+    if((format == PLY_FORMAT_BINARY_BIG_ENDIAN) != PLY_HOST_BIG_ENDIAN) {
+        for(size_t i = 0; i < size / 2; i++) {
+            uint8_t byte = bytes[i];
+
+            bytes[i] = bytes[size - 1 - i];
+            bytes[size - 1 - i] = byte;
+        }
+    }
+
+    fwrite(bytes, 1, size, pFile);
+}
+
+/**
+ * @brief Write vertex element body of checkWriteFacePLY model
+ */
+void checkWriteVertices(FILE* pFile, PLYFormat_t format) {
+    const float vertices[4][3] = { {0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 0.0f}, {0.0f, 1.0f, 0.0f} };
+
+    for(uint32_t v = 0; v < 4; v++) {
+        for(uint32_t c = 0; c < 3; c++) {
+            if(format == PLY_FORMAT_ASCII) {
+                fprintf(pFile, c == 2 ? "%g\n" : "%g ", vertices[v][c]);
+            }
+            else {
+                checkWriteValue(pFile, format, &vertices[v][c], sizeof(float));
+            }
+        }
+    }
+}
+
+/**
+ * @brief Write .ply model with 4 vertices (x, y, z floats), one triangle and one face with given amount of corners
+ *
+ * @param path output path
+ * @param format file format
+ * @param bigFace corners of second face
+ * @param faceFirst write face element before vertex element
+ * @return true when file was written
+ */
+bool checkWriteFacePLY(const char* path, PLYFormat_t format, uint16_t bigFace, bool faceFirst) {
+    FILE* file = fopen(path, "wb");
+
+    if(file == nullptr) {
+        return false;
+    }
+
+    const char* vertex_element = "element vertex 4\nproperty float x\nproperty float y\nproperty float z\n";
+    const char* face_element = "element face 2\nproperty list ushort uint vertex_indices\n";
+    uint32_t index_format = format == PLY_FORMAT_ASCII ? 0 : (format == PLY_FORMAT_BINARY_LITTLE_ENDIAN ? 1 : 2);
+
+    fprintf(file, "ply\nformat %s 1.0\n%s%send_header\n", gCheckFormatNames[index_format], faceFirst ? face_element : vertex_element, faceFirst ? vertex_element : face_element);
+
+    if(!faceFirst) {
+        checkWriteVertices(file, format);
+    }
+
+    const uint16_t face_sizes[2] = { 3, bigFace };
+
+    for(uint32_t f = 0; f < 2; f++) {
+        if(format == PLY_FORMAT_ASCII) {
+            fprintf(file, "%u", face_sizes[f]);
+        }
+        else {
+            checkWriteValue(file, format, &face_sizes[f], sizeof(uint16_t));
+        }
+
+        for(uint32_t i = 0; i < face_sizes[f]; i++) {
+            uint32_t index = i % 4;
+
+            if(format == PLY_FORMAT_ASCII) {
+                fprintf(file, " %u", index);
+            }
+            else {
+                checkWriteValue(file, format, &index, sizeof(uint32_t));
+            }
+        }
+
+        if(format == PLY_FORMAT_ASCII) {
+            fprintf(file, "\n");
+        }
+    }
+
+    if(faceFirst) {
+        checkWriteVertices(file, format);
+    }
+
+    return fclose(file) == 0;
+}
+
+void onCheckStreamBatch(void* pUser, const MeshBatch_t* pBatch) {
+    CheckStream_t* stream = (CheckStream_t*)pUser;
+
+    if(pBatch->mVertices != nullptr) {
+        stream->mVertexCount += pBatch->mVertices->mMeshSize;
+    }
+
+    stream->mIndexCount += pBatch->mIndexCount;
+}
+
+/**
+ * @brief Face with more corners than PLY_MAX_FACE_INDICES is skipped by whole file loaders, only triangle is loaded
+ */
+bool checkBigFaceLoad(const char* pDirectory) {
+    bool passed = true;
+
+    for(uint32_t f = 0; f < sizeof(gCheckFormats) / sizeof(gCheckFormats[0]); f++) {
+        char path[CHECK_MAX_PATH];
+        snprintf(path, CHECK_MAX_PATH, "%s/check_big_face_%s.ply", pDirectory, gCheckFormatNames[f]);
+
+        if(!checkWriteFacePLY(path, gCheckFormats[f], CHECK_BIG_FACE, false)) {
+            return false;
+        }
+
+        Mesh_t mesh, indexed;
+        MClearMesh(&mesh);
+        MClearMesh(&indexed);
+
+        MLoadPLYMeshFromFile(&mesh, path);
+        MLoadPLYIndexedMeshFromFile(&indexed, path);
+
+        passed = passed && mesh.mMeshSize == 3 && indexed.mMeshSize == 4 && indexed.mIndexCount == 3;
+
+        if(mesh.mMeshCapacity != 0) MFreeMesh(&mesh);
+        if(indexed.mMeshCapacity != 0) MFreeMesh(&indexed);
+
+        remove(path);
+    }
+
+    return passed;
+}
+
+/**
+ * @brief Face with more corners than PLY_MAX_FACE_INDICES is skipped by streaming loader, only triangle is streamed
+ */
+bool checkBigFaceStream(const char* pDirectory) {
+    bool passed = true;
+
+    for(uint32_t f = 0; f < sizeof(gCheckFormats) / sizeof(gCheckFormats[0]); f++) {
+        char path[CHECK_MAX_PATH];
+        snprintf(path, CHECK_MAX_PATH, "%s/check_big_face_stream_%s.ply", pDirectory, gCheckFormatNames[f]);
+
+        if(!checkWriteFacePLY(path, gCheckFormats[f], CHECK_BIG_FACE, false)) {
+            return false;
+        }
+
+        CheckStream_t stream = { 0, 0 };
+
+        passed = passed && MStreamPLYMeshFromFile(path, 0, onCheckStreamBatch, &stream) && stream.mVertexCount == 4 && stream.mIndexCount == 3;
+
+        remove(path);
+    }
+
+    return passed;
+}
+
+/**
+ * @brief Face element written before vertex element is triangulated from decoded positions, so model loads same as in usual order. Streaming loader rejects such file
+ */
+bool checkFaceBeforeVertex(const char* pDirectory) {
+    bool passed = true;
+
+    for(uint32_t f = 0; f < sizeof(gCheckFormats) / sizeof(gCheckFormats[0]); f++) {
+        char path[CHECK_MAX_PATH], reordered_path[CHECK_MAX_PATH];
+        snprintf(path, CHECK_MAX_PATH, "%s/check_order_%s.ply", pDirectory, gCheckFormatNames[f]);
+        snprintf(reordered_path, CHECK_MAX_PATH, "%s/check_order_face_first_%s.ply", pDirectory, gCheckFormatNames[f]);
+
+        if(!checkWriteFacePLY(path, gCheckFormats[f], 4, false) || !checkWriteFacePLY(reordered_path, gCheckFormats[f], 4, true)) {
+            return false;
+        }
+
+        Mesh_t mesh, reordered;
+        MClearMesh(&mesh);
+        MClearMesh(&reordered);
+
+        MLoadPLYMeshFromFile(&mesh, path);
+        MLoadPLYMeshFromFile(&reordered, reordered_path);
+
+        CheckStream_t stream = { 0, 0 };
+
+        passed = passed && mesh.mMeshSize == 9 && reordered.mMeshSize == mesh.mMeshSize && memcmp(reordered.mVertices, mesh.mVertices, sizeof(float) * 3 * mesh.mMeshSize) == 0;
+        passed = passed && !MStreamPLYMeshFromFile(reordered_path, 0, onCheckStreamBatch, &stream);
+
+        if(mesh.mMeshCapacity != 0) MFreeMesh(&mesh);
+        if(reordered.mMeshCapacity != 0) MFreeMesh(&reordered);
+
+        remove(path);
+        remove(reordered_path);
+    }
+
+    return passed;
+}
+
+/**
+ * @brief Indexed model without faces is cached with no indices, second load has to hit cache instead of writing it again
+ */
+bool checkCacheIndexedWithoutFaces(const char* pDirectory) {
+    char path[CHECK_MAX_PATH], cache_path[CHECK_MAX_PATH];
+    snprintf(path, CHECK_MAX_PATH, "%s/check_cache_no_faces.ply", pDirectory);
+    snprintf(cache_path, CHECK_MAX_PATH, "%s/check_cache_no_faces.ply.emesh", pDirectory);
+
+    FILE* file = fopen(path, "wb");
+
+    if(file == nullptr) {
+        return false;
+    }
+
+    fprintf(file, "ply\nformat ascii 1.0\nelement vertex 3\nproperty float x\nproperty float y\nproperty float z\nelement face 0\nproperty list uchar uint vertex_indices\nend_header\n0 0 0\n1 0 0\n0 1 0\n");
+    fclose(file);
+    remove(cache_path);
+
+    bool passed = true;
+    uint32_t saved = 0;
+
+    for(uint32_t r = 0; r < 2; r++) {
+        Mesh_t mesh;
+        MClearMesh(&mesh);
+
+        MLoadPLYMeshCached(&mesh, path, true, false);
+
+        passed = passed && mesh.mMeshSize == 3 && mesh.mIndexCount == 0;
+
+        if(r == 0) {
+            saved = atomic_load(&gMCTempCounter);
+        }
+
+        if(mesh.mMeshCapacity != 0) MFreeMesh(&mesh);
+    }
+
+    passed = passed && saved != 0 && atomic_load(&gMCTempCounter) == saved;
+
+    remove(cache_path);
+    remove(path);
+
+    return passed;
+}
+
+atomic_uint gCheckPoolGate = 0;
+atomic_uint gCheckPoolSum = 0;
+
+void checkPoolBlock(void* pArgs) {
+    (void)pArgs;
+
+    while(atomic_load(&gCheckPoolGate) == 0) {
+        sched_yield();
+    }
+}
+
+void checkPoolJob(void* pArgs, uint32_t job) {
+    (void)pArgs;
+    (void)job;
+
+    atomic_fetch_add(&gCheckPoolSum, 1);
+}
+
+void checkPoolTask(void* pArgs) {
+    MTParallelFor(CHECK_POOL_JOBS, checkPoolJob, pArgs);
+}
+
+void onCheckPoolMesh(void* pUser, uint32_t handle, Mesh_t* pMesh) {
+    (void)handle;
+
+    *(size_t*)pUser = pMesh->mMeshSize;
+
+    if(pMesh->mMeshCapacity != 0) MFreeMesh(pMesh);
+}
+
+/**
+ * @brief Tasks queued behind busy worker when pool stops are run, not dropped: parallel for helpers free their jobs and asset load is delivered
+ */
+bool checkPoolStopDrains(const char* pDirectory) {
+    char path[CHECK_MAX_PATH];
+    snprintf(path, CHECK_MAX_PATH, "%s/check_pool.ply", pDirectory);
+
+    if(!checkWriteFacePLY(path, PLY_FORMAT_ASCII, 4, false)) {
+        return false;
+    }
+
+    uint32_t thread_count = MTGetThreadCount();
+    size_t loaded = 0;
+
+    MTPoolStop();
+    MTSetThreadCount(4);
+
+    atomic_store(&gCheckPoolSum, 0);
+    atomic_store(&gCheckPoolGate, 0);
+    MTPoolStart(1);
+
+    MECStats_t before;
+    MECGetStats(&before);
+
+    MTSubmit(checkPoolBlock, nullptr);
+
+    for(uint32_t t = 0; t < CHECK_POOL_TASKS; t++) {
+        MTSubmit(checkPoolTask, nullptr);
+    }
+
+    atomic_store(&gCheckPoolGate, 1);
+    MTPoolStop();
+
+    MECStats_t after;
+    MECGetStats(&after);
+
+    // every queued task and parallel for block is freed by stop
+    bool passed = atomic_load(&gCheckPoolSum) == CHECK_POOL_TASKS * CHECK_POOL_JOBS;
+    passed = passed && after.mMallocCount + after.mCallocCount - before.mMallocCount - before.mCallocCount == after.mFreeCount - before.mFreeCount;
+
+    atomic_store(&gCheckPoolGate, 0);
+    MTPoolStart(1);
+    MTSubmit(checkPoolBlock, nullptr);
+
+    uint32_t handle = ASLoadMesh(path, false, false, onCheckPoolMesh, &loaded);
+
+    atomic_store(&gCheckPoolGate, 1);
+    MTPoolStop();
+
+    while(!ASIsIdle()) {
+        MTRunMainQueue(1.0);
+    }
+
+    passed = passed && ASGetState(handle) == AS_STATE_READY && loaded == 9;
+
+    MTSetThreadCount(thread_count);
+    remove(path);
+
+    return passed;
+}
+
+/**
+ * @brief Rejoin of mesh data emptied after join resets joined bounds
+ */
+bool checkRejoinEmpty(const char* pDirectory) {
+    (void)pDirectory;
+
+    MeshData_t data;
+    memset(&data, 0, sizeof(MeshData_t));
+
+    Mesh_t mesh;
+    MClearMesh(&mesh);
+    MAllocMesh(&mesh, 3);
+
+    for(uint32_t i = 0; i < 9; i++) {
+        mesh.mVertices[i] = (float)(i + 1);
+    }
+
+    MDAddMesh(&data, mesh);
+    MDRejoin(&data);
+
+    bool passed = data.mJoinedMesh.mMeshSize == 3 && data.mJoinedMesh.mBoundsMax[0] == 7.0f;
+
+    data.mMeshes[0].mMeshSize = 0;
+    MDRejoin(&data);
+
+    const float zero[3] = { 0.0f, 0.0f, 0.0f };
+
+    passed = passed && data.mJoinedMesh.mMeshSize == 0 && memcmp(data.mJoinedMesh.mBoundsMin, zero, sizeof(zero)) == 0 && memcmp(data.mJoinedMesh.mBoundsMax, zero, sizeof(zero)) == 0;
+
+    MFreeMesh(&data.mMeshes[0]);
+    MFreeMesh(&data.mJoinedMesh);
+
+    void* arrays[] = { data.mMeshes, data.mMeshTransform, data.mTextureID, data.mMeshID, data.mMeshStart, data.mIndexStart, data.mMeshLod, data.mMeshDirty, data.mTransformDirty };
+
+    for(uint32_t i = 0; i < sizeof(arrays) / sizeof(arrays[0]); i++) {
+        if(arrays[i] != nullptr) MECFree(arrays[i]);
+    }
+
+    return passed;
+}
+
+const CheckCase_t gCheckCases[] = {
+    { "big face load", checkBigFaceLoad },
+    { "big face stream", checkBigFaceStream },
+    { "face before vertex", checkFaceBeforeVertex },
+    { "cache indexed without faces", checkCacheIndexedWithoutFaces },
+    { "pool stop drains queue", checkPoolStopDrains },
+    { "rejoin empty mesh data", checkRejoinEmpty },
+};
+
+int main(int argc, char** argv) {
+    const char* directory = argc > 1 ? argv[1] : ".";
+    uint32_t failed = 0;
+
+    for(uint32_t c = 0; c < sizeof(gCheckCases) / sizeof(gCheckCases[0]); c++) {
+        bool passed = gCheckCases[c].mFn(directory);
+
+        printf("%-32s %s\n", gCheckCases[c].mName, passed ? "ok" : "FAILED");
+        failed += !passed;
+    }
+
+    printf("%u of %zu checks failed\n", failed, sizeof(gCheckCases) / sizeof(gCheckCases[0]));
+
+    return failed == 0 ? 0 : 1;
+}
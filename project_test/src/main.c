@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include "../../engine/window.h"
 #include "../../engine/renderer.h"
+#include "../../engine/assets.h"
 
 void defHandler() {
 
@@ -11,14 +12,25 @@ Renderer_t gRend;
 MeshData_t gMeshData;
 RenderData_t gRenderData;
 
-void start() {
-    MClearMesh(&gTestMesh);
-    MLoadPLYMeshFromFile(&gTestMesh, "../cubeBin.ply");
+void onMeshLoaded(void* pUser, uint32_t handle, Mesh_t* pMesh) {
+    (void)pUser;
+    (void)handle;
+
+    if(pMesh->mMeshSize == 0) {
+        return;
+    }
+
+    gTestMesh = *pMesh;
 
     MDAddMesh(&gMeshData, gTestMesh);
     MDRejoin(&gMeshData);
 
-    RDBindMesh(&gRenderData, &gMeshData);
+    ASBindMesh(&gRenderData, &gMeshData);
+}
+
+void start() {
+    MClearMesh(&gTestMesh);
+    ASLoadMesh("../cubeBin.ply", true, false, onMeshLoaded, nullptr);
 
     // RTestSetup(&gRend);
 }